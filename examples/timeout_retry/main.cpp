@@ -1,7 +1,6 @@
 #include <jsonrpc/jsonrpc.hpp>
 #include <chrono>
 #include <iostream>
-#include <thread>
 
 using namespace jsonrpc;
 
@@ -9,21 +8,22 @@ int main() {
     Client client("127.0.0.1", 9000);  // 故意连接到没有服务的端口
     client.set_timeout(std::chrono::milliseconds(500));
 
-    const int max_attempts = 3;
-    for (int attempt = 1; attempt <= max_attempts; ++attempt) {
-        try {
-            std::cout << "第 " << attempt << " 次尝试调用 ping()" << std::endl;
-            client.call<int>("ping");
-            std::cout << "调用成功" << std::endl;
-            break;
-        } catch (const Error& e) {
-            std::cerr << "调用失败: " << e.message() << std::endl;
-            if (attempt == max_attempts) {
-                std::cerr << "达到最大重试次数" << std::endl;
-            } else {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-            }
-        }
+    // 网络错误时最多尝试 3 次，退避上限从 200ms 开始翻倍（带随机抖动）
+    RetryPolicy retry;
+    retry.max_attempts = 3;
+    retry.initial_backoff = std::chrono::milliseconds(200);
+    retry.max_backoff = std::chrono::seconds(1);
+    client.set_retry_policy(retry);
+
+    // 只有幂等方法会被重试
+    client.set_idempotent("ping");
+
+    try {
+        std::cout << "调用 ping()（最多尝试 " << retry.max_attempts << " 次）" << std::endl;
+        client.call<int>("ping");
+        std::cout << "调用成功" << std::endl;
+    } catch (const Error& e) {
+        std::cerr << "调用失败: " << e.message() << std::endl;
     }
 
     return 0;
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+/**
+ * @file call_context.hpp
+ * @brief 方法调用的上下文（调用方的截止时间与取消状态）
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 单次方法调用的上下文
+ *
+ * 方法的第一个参数声明为 const CallContext& 时，服务端把本次调用的上下文传入，
+ * 其余参数照常从 params 转换；不声明则行为不变。长时间运行的方法可以定期检查
+ * cancelled()，客户端断开连接后提前结束。
+ *
+ * 使用示例：
+ * @code
+ * server.register_method("search", [](const jsonrpc::CallContext& ctx, std::string query) {
+ *     return index.search(query, ctx.remaining());  // 按调用方剩余的等待时间裁剪工作量
+ * });
+ * @endcode
+ */
+class CallContext {
+public:
+    typedef std::chrono::steady_clock clock;
+
+    /**
+     * @brief 无截止时间的上下文
+     */
+    CallContext()
+        : deadline_(clock::time_point::max())
+    {}
+
+    /**
+     * @brief 带截止时间的上下文
+     * @param deadline 调用方放弃等待的时刻
+     * @param cancelled 取消标志（由服务端会话在客户端断开时置位，可为空）
+     */
+    explicit CallContext(clock::time_point deadline,
+                         std::shared_ptr<const std::atomic<bool>> cancelled = nullptr)
+        : deadline_(deadline)
+        , cancelled_(std::move(cancelled))
+    {}
+
+    /**
+     * @brief 调用方是否告知了截止时间
+     */
+    bool has_deadline() const {
+        return deadline_ != clock::time_point::max();
+    }
+
+    /**
+     * @brief 截止时间（没有时为 time_point::max()）
+     */
+    clock::time_point deadline() const {
+        return deadline_;
+    }
+
+    /**
+     * @brief 距截止时间的剩余时长（已过期为 0，没有截止时间为 milliseconds::max()）
+     */
+    std::chrono::milliseconds remaining() const {
+        if (!has_deadline()) {
+            return std::chrono::milliseconds::max();
+        }
+        auto now = clock::now();
+        if (now >= deadline_) {
+            return std::chrono::milliseconds(0);
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - now);
+    }
+
+    /**
+     * @brief 是否已过截止时间（调用方已不再等待结果）
+     */
+    bool expired() const {
+        return has_deadline() && clock::now() >= deadline_;
+    }
+
+    /**
+     * @brief 调用是否已被取消（客户端已断开，结果不会再被读取）
+     */
+    bool cancelled() const {
+        return cancelled_ && cancelled_->load(std::memory_order_acquire);
+    }
+
+private:
+    clock::time_point deadline_;
+    std::shared_ptr<const std::atomic<bool>> cancelled_;
+};
+
+} // namespace jsonrpc
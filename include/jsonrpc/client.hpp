@@ -3,11 +3,19 @@
 #include <jsonrpc/config.hpp>
 #include <jsonrpc/types.hpp>
 #include <jsonrpc/errors.hpp>
+#include <jsonrpc/transport.hpp>
+#include <jsonrpc/endpoint.hpp>
+#include <jsonrpc/retry.hpp>
+#include <jsonrpc/concurrency_limit.hpp>
+#include <jsonrpc/detail/typed_completion.hpp>
+#include <boost/asio/async_result.hpp>
 #include <boost/json.hpp>
 #include <memory>
 #include <string>
 #include <functional>
 #include <chrono>
+#include <type_traits>
+#include <vector>
 
 /**
  * @file client.hpp
@@ -52,11 +60,23 @@ class JSONRPC_DECL Client {
 public:
     /**
      * @brief 构造客户端
-     * @param host 服务器地址（如 "127.0.0.1" 或 "example.com"）
-     * @param port 服务器端口
+     * @param host 服务器地址（如 "127.0.0.1" 或 "example.com"），
+     *             "unix:/path/to/socket" 表示连接 Unix 域套接字
+     * @param port 服务器端口（Unix 域套接字时忽略）
      */
     Client(const std::string& host, unsigned short port);
 
+    /**
+     * @brief 构造多端点客户端
+     *
+     * 每次调用按负载均衡策略选择一个端点（默认最少在途请求），
+     * 每个端点有各自的连接池与多路复用连接。批量调用整批发往同一个端点。
+     *
+     * @param endpoints 服务端端点（同一服务的多个副本）
+     * @throws std::invalid_argument endpoints 为空
+     */
+    explicit Client(const std::vector<Endpoint>& endpoints);
+
     /**
      * @brief 析构函数
      */
@@ -82,6 +102,219 @@ public:
      */
     void set_logger(std::function<void(const std::string&)> logger);
 
+    /**
+     * @brief 设置传输方式
+     *
+     * 必须与服务器的传输方式一致，默认 Transport::Http。
+     * 原始 TCP 传输下，异步调用共用一条长连接，多个请求同时在途、响应按 id 匹配；
+     * 同步调用每次使用独立连接，通知经通知队列在后台长连接上发送。
+     * 应在发起调用之前设置，切换时正在进行的异步调用不受影响。
+     *
+     * @param transport 传输方式
+     */
+    void set_transport(Transport transport);
+
+    /**
+     * @brief 获取当前传输方式
+     */
+    Transport transport() const;
+
+    /**
+     * @brief 启用异步调用自动合批
+     *
+     * 启用后 async_call() 不立即发送，而是先进入缓冲：缓冲达到 max_batch 个请求，
+     * 或其中第一个请求已等待 max_delay 时，整批作为一个 JSON-RPC 批量请求发出，
+     * 响应按 id 分发回各自的回调。HTTP 帧与系统调用的开销由整批分摊，
+     * 适合短时间内大量小调用的场景；代价是每个调用最多多等待 max_delay。
+     * 同步调用、批量调用与通知不受影响。
+     *
+     * @param max_batch 单批最多请求数（不大于 1 表示关闭，默认关闭）
+     * @param max_delay 第一个请求的最长等待时间
+     */
+    void set_auto_batching(std::size_t max_batch, std::chrono::milliseconds max_delay);
+
+    /**
+     * @brief 设置 HTTP 异步调用是否使用流水线（HTTP/1.1 pipelining）
+     *
+     * 启用后所有 async_call() 共用一条连接，请求逐个写出而不等待前一个响应，
+     * 响应按请求顺序返回并匹配回调，单个 socket 即可承载很高的请求速率。
+     * 服务端按顺序逐个处理同一连接上的请求，慢请求会推迟其后的响应；
+     * 需要乱序完成时请使用原始 TCP 传输（始终多路复用，按 id 匹配）。
+     * 同步调用不受影响，仍使用连接池。
+     *
+     * @param enable 是否启用（默认 false）
+     */
+    void set_pipelining(bool enable);
+
+    /**
+     * @brief HTTP 异步调用是否使用流水线
+     */
+    bool pipelining() const;
+
+    /**
+     * @brief 设置内部 I/O 线程数
+     *
+     * count > 0 时客户端自己启动 count 个线程运行 io_context，异步调用的回调、
+     * use_future 等完成令牌无需调用方运行事件循环即可完成；此时不能再调用
+     * run() / poll() / run_for() / run_until_idle()（抛出 std::logic_error）。
+     * 同一个 Client 可被任意多个线程同时使用（call、async_call、call_batch、notify）：
+     * 请求 id 由原子计数生成，HTTP 连接从带锁的连接池中独占取用，
+     * 每条连接的异步操作与超时处理都在该连接自己的 strand 上串行执行。
+     * 回调会在不同的 I/O 线程中并发执行，需要自行保证线程安全。
+     * 其余配置方法（set_timeout、set_transport 等）应在共享之前调用。
+     *
+     * count 为 0 时停止内部线程（等待在途的异步调用完成或超时），恢复由调用方运行事件循环。
+     * 析构时同样等待在途的异步调用完成。不能在回调（I/O 线程）中调用。
+     *
+     * @param count I/O 线程数（默认 0）
+     * @throws std::logic_error 在客户端的 I/O 线程中调用
+     */
+    void set_io_threads(std::size_t count);
+
+    /**
+     * @brief 当前内部 I/O 线程数（0 表示由调用方运行事件循环）
+     */
+    std::size_t io_threads() const;
+
+    /**
+     * @brief 设置 DNS 解析缓存的有效期
+     *
+     * 同一个 Client 的所有连接共用一份解析结果，建立新连接时不必再经过系统解析器。
+     * 条目过期后下一次连接仍立即使用旧结果，同时在后台线程重新解析并替换；
+     * 连接失败时丢弃对应条目，下次连接重新解析。Unix 域套接字不经过 DNS。
+     *
+     * @param ttl 有效期（默认 30 秒，0 表示关闭缓存，每次连接都解析）
+     */
+    void set_dns_cache_ttl(std::chrono::milliseconds ttl);
+
+    /**
+     * @brief 设置多端点的负载均衡策略
+     *
+     * @param policy 选择策略（默认 LoadBalancePolicy::LeastOutstanding）
+     */
+    void set_load_balancing(LoadBalancePolicy policy);
+
+    /**
+     * @brief 设置异常端点摘除
+     *
+     * 端点连续出现 consecutive_failures 次网络错误（连接失败、超时、连接断开）后
+     * 暂停向其分发调用，duration 期满后重新加入；重新加入后再失败一次即再次摘除。
+     * 服务端返回的 RPC 错误不计为失败。所有端点都被摘除时仍在全部端点中选择。
+     *
+     * @param consecutive_failures 连续失败阈值（默认 5，0 表示不摘除）
+     * @param duration 摘除时长（默认 10 秒）
+     */
+    void set_outlier_ejection(std::size_t consecutive_failures, std::chrono::milliseconds duration);
+
+    /**
+     * @brief 各端点的在途请求数、延迟与摘除状态（按构造时的顺序）
+     */
+    std::vector<EndpointStatus> endpoint_status() const;
+
+    /**
+     * @brief 设置每个端点的自适应并发上限
+     *
+     * 每个端点的在途调用（同步与异步，合批请求计为一个）不超过一个自动调整的上限：
+     * Gradient 算法在延迟相对长期平均值上升时收缩上限，AIMD 算法在网络错误或超时时收缩；
+     * 调用顺利时上限逐步放大。超出上限的调用进入等待队列，排队超过超时时间或队列已满时
+     * 以 ErrorCode::Overloaded 失败（同步调用抛出 Error，异步调用经回调返回），请求不会发出。
+     * 当前上限可通过 endpoint_status() 观察。
+     *
+     * @param policy 策略（默认不限制；max_limit 为 0 表示关闭）
+     */
+    void set_concurrency_limit(const ConcurrencyLimitPolicy& policy);
+
+    /**
+     * @brief 标记方法为幂等（可以安全地重复执行）
+     *
+     * 只有幂等方法会按 set_retry_policy() 重试、按 set_hedging() 发出对冲副本，
+     * 其他方法的调用行为不变。幂等方法的异步调用不参与自动合批。
+     *
+     * @param method 方法名
+     * @param idempotent 是否幂等
+     */
+    void set_idempotent(const std::string& method, bool idempotent = true);
+
+    /**
+     * @brief 设置幂等方法在网络错误时的重试策略
+     *
+     * 同步与异步调用都生效；按指数退避加随机抖动等待后重试，服务端返回的 RPC 错误不重试。
+     *
+     * @param policy 重试策略（默认只尝试一次）
+     */
+    void set_retry_policy(const RetryPolicy& policy);
+
+    /**
+     * @brief 设置幂等方法的对冲请求
+     *
+     * 调用在最近成功调用延迟的分位数（不小于 min_delay）内没有响应时，再发出一份副本：
+     * HTTP 传输下经连接池中的另一条连接，原始 TCP 传输下在多路复用连接上；
+     * 多端点时由负载均衡选择端点（默认策略会避开原请求所在端点）。最先到达的响应作为结果。
+     * 同步调用启用对冲或重试时，未启用内部 I/O 线程则在调用线程中运行事件循环直到完成。
+     *
+     * @param policy 对冲策略（默认关闭；max_hedges 为 0 表示关闭）
+     */
+    void set_hedging(const HedgePolicy& policy);
+
+    /**
+     * @brief 设置通知队列
+     *
+     * notify() 默认只在调用方线程序列化并放入有界队列，立即返回；
+     * 后台线程通过一条长连接把队列中积压的通知一次写出（HTTP 传输下为流水线请求），
+     * 调用方不等待连接建立和服务端响应。通知尽力送达，网络错误时被丢弃并记录日志。
+     * 队列满时按 policy 阻塞调用方或丢弃本条通知；Client 析构时发送完队列中剩余的通知。
+     *
+     * @param capacity 队列容量（默认 1024，0 表示关闭队列，notify() 同步发送）
+     * @param policy 队列满时的处理方式（默认 NotifyOverflow::Block）
+     */
+    void set_notify_queue(std::size_t capacity, NotifyOverflow policy = NotifyOverflow::Block);
+
+    /**
+     * @brief 阻塞直到已入队的通知全部写出
+     */
+    void flush_notifications();
+
+    /**
+     * @brief 因通知队列已满而丢弃的通知数（NotifyOverflow::Drop）
+     */
+    std::size_t dropped_notifications() const;
+
+    /**
+     * @brief 设置 HTTP 连接池最多保留的空闲连接数
+     *
+     * HTTP 传输下每次调用完成后连接保持打开（keep-alive）并归还连接池，
+     * 后续的同步、异步调用优先复用空闲连接，省去 DNS 解析与 TCP 握手。
+     * 超出上限的连接在调用完成后关闭。
+     *
+     * @param count 空闲连接上限（默认 8，0 表示每次调用后关闭连接）
+     */
+    void set_max_idle_connections(std::size_t count);
+
+    /**
+     * @brief 设置空闲连接的最长保留时间
+     *
+     * 超时的空闲连接在下次取用或归还连接时关闭。应短于服务端的 keep-alive 超时（30 秒）。
+     *
+     * @param timeout 最长空闲时间（默认 15 秒）
+     */
+    void set_idle_timeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 预先建立 HTTP 连接
+     *
+     * 同步建立 count 个连接放入连接池（受空闲连接上限约束，多端点时每个端点各 count 个），
+     * 使首批调用不必等待连接建立。通常在构造并完成配置后调用。
+     *
+     * @param count 连接数
+     * @throws Error 网络错误
+     */
+    void preconnect(std::size_t count);
+
+    /**
+     * @brief 当前连接池中的空闲连接数（多端点时为各端点之和）
+     */
+    std::size_t idle_connections() const;
+
     /**
      * @brief 同步调用 RPC 方法
      *
@@ -127,6 +360,43 @@ public:
                     std::function<void(const Response&)> callback,
                     Args&&... args);
 
+    /**
+     * @brief 异步调用 RPC 方法（Asio 完成令牌）
+     *
+     * 完成签名为 void(boost::system::error_code, Result)：RPC 错误和返回值类型不匹配
+     * 以 jsonrpc::error_category() 中的错误码报告（值为 JSON-RPC 错误码）；
+     * Result 为 Response 时错误保留在响应中，Result 为 void 时签名为 void(boost::system::error_code)。
+     * 支持任意 Asio 完成令牌：普通处理器、use_future、yield_context、use_awaitable（C++20）等。
+     * 结果在处理器的关联执行器上交付（未关联时在客户端的 io_context 中）；
+     * 网络 I/O 仍在客户端的 io_context 中进行，需要有线程运行它。
+     * 出错时 Result 以默认值构造，因此 Result 须可默认构造。
+     *
+     * @tparam Result 返回值类型
+     * @tparam CompletionToken 完成令牌类型
+     * @tparam Args 参数类型
+     * @param method 方法名
+     * @param token 完成令牌
+     * @param args 方法参数
+     * @return 由完成令牌决定（如 use_future 返回 std::future<Result>）
+     *
+     * @code
+     * std::future<int> f = client.async_call<int>("add", boost::asio::use_future, 1, 2);
+     *
+     * client.async_call<int>("add", [](boost::system::error_code ec, int sum) {
+     *     // ...
+     * }, 1, 2);
+     *
+     * int sum = co_await client.async_call<int>("add", boost::asio::use_awaitable, 1, 2);
+     * @endcode
+     */
+    template<typename Result, typename CompletionToken, typename... Args>
+    auto async_call(const std::string& method, CompletionToken&& token, Args&&... args)
+        -> typename std::enable_if<
+               !detail::is_response_callback<CompletionToken>::value,
+               typename boost::asio::async_result<
+                   typename std::decay<CompletionToken>::type,
+                   typename detail::call_completion<Result>::signature>::return_type>::type;
+
     /**
      * @brief 批量同步调用
      *
@@ -141,7 +411,8 @@ public:
     /**
      * @brief 发送通知（无响应）
      *
-     * 发送通知类型的请求，不等待响应。
+     * 发送通知类型的请求，不等待响应：序列化后放入通知队列即返回，
+     * 由后台线程发送（见 set_notify_queue()）。
      *
      * @tparam Args 参数类型
      * @param method 方法名
@@ -154,11 +425,43 @@ public:
     template<typename... Args>
     void notify(const std::string& method, Args&&... args);
 
+    /**
+     * @brief 以已转换好的参数数组同步调用
+     *
+     * 与 call() 相同，但参数已是 JSON 数组，RPC 错误保留在响应中而不抛出。
+     * 供需要先检查参数再决定目标的上层（如 ShardedClient）使用。
+     *
+     * @param method 方法名
+     * @param params 位置参数
+     * @return 响应
+     */
+    Response call_params(const std::string& method, boost::json::array params);
+
+    /**
+     * @brief 以已转换好的参数数组异步调用
+     *
+     * @param method 方法名
+     * @param params 位置参数
+     * @param callback 回调函数 void(const Response&)
+     */
+    void async_call_params(const std::string& method, boost::json::array params,
+                           std::function<void(const Response&)> callback);
+
+    /**
+     * @brief 以已转换好的参数数组发送通知
+     *
+     * @param method 方法名
+     * @param params 位置参数
+     */
+    void notify_params(const std::string& method, boost::json::array params);
+
     /**
      * @brief 运行事件循环（阻塞）
      *
      * 处理所有待处理的异步响应，直到所有操作完成。
      * 用于异步调用后等待响应。
+     *
+     * @throws std::logic_error 已启用内部 I/O 线程（同样适用于 poll、run_for、run_until_idle）
      */
     void run();
 
@@ -203,6 +506,10 @@ public:
 
 private:
     class Impl;
+
+    template<typename Result>
+    class CallInitiation;
+
     std::unique_ptr<Impl> impl_;
 };
 
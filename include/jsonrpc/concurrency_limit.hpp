@@ -0,0 +1,50 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <cstddef>
+
+/**
+ * @file concurrency_limit.hpp
+ * @brief 客户端自适应并发上限
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 并发上限的调整算法
+ */
+enum class LimitAlgorithm {
+    Aimd,       ///< 加性增、乘性减：成功时上限约每一轮 +1，网络错误或超时时乘以 backoff_ratio
+    Gradient    ///< 梯度：按长期平均延迟与本次延迟之比缩放上限，延迟上升即收缩（默认）
+};
+
+/**
+ * @brief 每个端点的在途调用上限
+ *
+ * 上限根据实测延迟与网络错误在 [min_limit, max_limit] 内自动调整。
+ * 达到上限的调用进入等待队列（最多 max_queue 个），队列也满时立即以 ErrorCode::Overloaded 失败，
+ * 不建立连接、不发送请求。
+ */
+struct ConcurrencyLimitPolicy {
+    ConcurrencyLimitPolicy()
+        : algorithm(LimitAlgorithm::Gradient)
+        , initial_limit(20)
+        , min_limit(1)
+        , max_limit(200)
+        , max_queue(0)
+        , backoff_ratio(0.9)
+        , tolerance(1.5)
+    {}
+
+    LimitAlgorithm algorithm;   ///< 调整算法
+    std::size_t initial_limit;  ///< 初始上限
+    std::size_t min_limit;      ///< 上限的下界
+    std::size_t max_limit;      ///< 上限的上界（0 表示不限制并发）
+    std::size_t max_queue;      ///< 每个端点等待队列的长度（0 表示超出上限立即失败）
+    double backoff_ratio;       ///< 网络错误或超时时上限的缩小倍数
+    double tolerance;           ///< Gradient：延迟超过长期平均值多少倍才开始收缩
+};
+
+} // namespace jsonrpc
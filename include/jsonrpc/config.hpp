@@ -5,6 +5,15 @@
 #  error "This library requires C++11 or later"
 #endif
 
+// C++20 协程方法（可选，需 -DJSONRPC_ENABLE_COROUTINES 且以 C++20 编译）
+#ifdef JSONRPC_ENABLE_COROUTINES
+#  if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#    define JSONRPC_HAS_COROUTINES 1
+#  else
+#    error "JSONRPC_ENABLE_COROUTINES requires C++20"
+#  endif
+#endif
+
 // Header-only 模式配置
 #ifdef JSONRPC_HEADER_ONLY
 #  define JSONRPC_DECL
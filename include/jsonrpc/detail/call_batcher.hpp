@@ -0,0 +1,89 @@
+#pragma once
+
+#include <jsonrpc/types.hpp>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @file call_batcher.hpp
+ * @brief 客户端异步调用自动合批
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 异步调用合批器
+ *
+ * 缓冲 async_call() 发起的请求，数量达到 max_batch 或第一个请求等待满 max_delay 时，
+ * 把缓冲中的请求作为一个 JSON-RPC 批量请求交给发送函数。
+ * add() 可在任意线程调用；缓冲只在内部 strand 上访问。
+ */
+class CallBatcher : public std::enable_shared_from_this<CallBatcher> {
+public:
+    typedef std::function<void(const Response&)> Callback;
+
+    /**
+     * @brief 发送函数：requests 与 callbacks 一一对应，内容可被移走
+     */
+    typedef std::function<void(std::vector<Request>&, std::vector<Callback>&)> Sender;
+
+    /**
+     * @brief 构造合批器
+     *
+     * @param io_context I/O 上下文（定时器与 strand 所在）
+     * @param max_batch 单批最多请求数
+     * @param max_delay 第一个请求最长等待时间
+     * @param sender 发送函数（在 strand 上调用）
+     */
+    CallBatcher(boost::asio::io_context& io_context,
+                std::size_t max_batch,
+                std::chrono::milliseconds max_delay,
+                Sender sender);
+
+    /**
+     * @brief 加入一个请求
+     */
+    void add(const Request& request, Callback callback);
+
+private:
+    void enqueue(Request& request, Callback& callback);
+    void flush();
+    void on_timer(boost::system::error_code ec);
+
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;   ///< 缓冲的串行执行器
+    boost::asio::steady_timer timer_;                                     ///< 等待时间定时器
+    std::size_t max_batch_;                                               ///< 单批最多请求数
+    std::chrono::milliseconds max_delay_;                                 ///< 最长等待时间
+    Sender sender_;                                                       ///< 发送函数
+    std::vector<Request> requests_;                                       ///< 缓冲中的请求
+    std::vector<Callback> callbacks_;                                     ///< 对应的回调
+    bool timer_armed_;                                                    ///< 定时器是否在等待
+};
+
+/**
+ * @brief 把批量响应按 id 分发给各请求的回调
+ *
+ * 找不到对应响应的请求以 InternalError 完成。
+ *
+ * @param ids 各请求的 id（与 callbacks 一一对应）
+ * @param callbacks 各请求的回调
+ * @param responses 批量响应（顺序任意）
+ */
+void fan_out_responses(const std::vector<std::int64_t>& ids,
+                       std::vector<CallBatcher::Callback>& callbacks,
+                       const std::vector<Response>& responses);
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/call_batcher.ipp>
+#endif
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <jsonrpc/types.hpp>
+#include <jsonrpc/detail/stream_endpoint.hpp>
+#include <jsonrpc/detail/endpoint_cache.hpp>
 #include <boost/asio.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
@@ -24,7 +26,11 @@ namespace detail {
 /**
  * @brief 客户端会话
  *
- * 管理单个 HTTP 请求/响应，支持同步和异步操作。
+ * 一条 HTTP/1.1 keep-alive 连接，同一时刻只承载一个请求/响应，支持同步和异步操作。
+ * 首次请求时建立连接，请求完成后连接保持打开，可由连接池交给下一次调用复用；
+ * 出错或服务端要求关闭时连接随之关闭，下次请求自动重连。
+ * 解析器与连接流绑定在会话自己的 strand 上，客户端以多个线程运行 io_context 时，
+ * 同一连接上的异步回调与超时处理不会并发执行。
  * 使用 shared_from_this 确保异步操作期间对象有效。
  */
 class ClientSession : public std::enable_shared_from_this<ClientSession> {
@@ -33,16 +39,19 @@ public:
      * @brief 构造会话
      *
      * @param io_context I/O 上下文
-     * @param host 服务器地址
+     * @param host 服务器地址（"unix:/path" 表示 Unix 域套接字）
      * @param port 服务器端口
      * @param timeout 超时时间
+     * @param logger 日志回调
+     * @param endpoint_cache DNS 解析缓存（为空时每次连接都解析）
      */
     ClientSession(
         boost::asio::io_context& io_context,
         const std::string& host,
         const std::string& port,
         std::chrono::milliseconds timeout,
-        std::function<void(const std::string&)> logger
+        std::function<void(const std::string&)> logger,
+        std::shared_ptr<EndpointCache> endpoint_cache = nullptr
     );
 
     /**
@@ -72,6 +81,17 @@ public:
     void async_call(const Request& request,
                     std::function<void(const Response&)> callback);
 
+    /**
+     * @brief 异步批量调用
+     *
+     * 网络错误或响应无法解析时，为每个请求生成一个错误响应（id 为对应请求的 id）。
+     *
+     * @param requests 请求列表
+     * @param callback 回调函数（参数为批量响应，顺序与服务端返回一致）
+     */
+    void async_call_batch(const std::vector<Request>& requests,
+                          std::function<void(const std::vector<Response>&)> callback);
+
     /**
      * @brief 发送通知（无响应）
      *
@@ -79,14 +99,44 @@ public:
      */
     void notify(const Request& request);
 
+    /**
+     * @brief 同步建立连接（已连接时直接返回）
+     * @throws Error 网络错误
+     */
+    void connect();
+
+    /**
+     * @brief 关闭连接
+     */
+    void close();
+
+    /**
+     * @brief 连接是否仍可复用（已连接且对端未关闭）
+     */
+    bool reusable();
+
 private:
+    /**
+     * @brief 构造 HTTP 请求
+     *
+     * @param request_body 请求 body
+     * @param with_timeout 是否在请求头中告知服务端本端的等待时间（通知不需要）
+     */
+    void prepare_request(const std::string& request_body, bool with_timeout);
+
+    /**
+     * @brief 取出响应 body，服务端要求关闭时关闭连接
+     */
+    std::string take_response_body();
+
     /**
      * @brief 同步发送请求并接收响应
      *
      * @param request_body 请求 body（JSON 字符串）
+     * @param with_timeout 是否在请求头中告知服务端本端的等待时间
      * @return 响应 body（JSON 字符串）
      */
-    std::string send_request_sync(const std::string& request_body);
+    std::string send_request_sync(const std::string& request_body, bool with_timeout = true);
 
     /**
      * @brief 异步发送请求
@@ -112,19 +162,27 @@ private:
      */
     void do_read(std::function<void(boost::beast::error_code)> callback);
 
+    /**
+     * @brief HTTP Host 头（Unix 域套接字使用 "localhost"）
+     */
+    std::string host_header() const;
+
     void log(const std::string& message) const;
 
     boost::asio::io_context& io_context_;                       ///< I/O 上下文
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;  ///< 连接的串行执行器（多 I/O 线程时保护流与超时定时器）
     boost::asio::ip::tcp::resolver resolver_;                   ///< DNS 解析器
-    boost::beast::tcp_stream stream_;                           ///< TCP 流
+    stream_type stream_;                                        ///< 连接流（TCP 或 Unix 域套接字）
     std::string host_;                                          ///< 服务器地址
     std::string port_;                                          ///< 服务器端口
     std::chrono::milliseconds timeout_;                         ///< 超时时间
     std::function<void(const std::string&)> logger_;             ///< 日志回调
+    std::shared_ptr<EndpointCache> endpoint_cache_;             ///< DNS 解析缓存（可为空）
 
     boost::beast::flat_buffer buffer_;                          ///< 读取缓冲区
     boost::beast::http::request<boost::beast::http::string_body> req_;   ///< HTTP 请求
     boost::beast::http::response<boost::beast::http::string_body> res_;  ///< HTTP 响应
+    bool connected_;                                            ///< 连接是否已建立
 };
 
 } // namespace detail
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <jsonrpc/concurrency_limit.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @file concurrency_limiter.hpp
+ * @brief 单个端点的自适应并发上限
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 自适应并发限制器
+ *
+ * acquire() 在在途数低于上限时立即放行，否则进入等待队列或拒绝；
+ * 每次完成由 release() 报告延迟与是否发生网络错误，按 AIMD 或梯度算法调整上限，
+ * 并放行队列中等待的调用。排队达到 max_wait 的调用被拒绝：构造时给出执行器时，
+ * 由定时器在到期时拒绝（在执行器上回调）；否则只在其他调用申请或归还名额时检查。
+ * 放行与拒绝的回调在锁外调用，可能在 acquire()、其他调用的 release() 或定时器中执行。
+ * 所有成员函数线程安全。使用定时器时，限制器必须比执行器上挂起的定时器回调活得更久
+ * （如随 io_context 一起销毁）。
+ */
+class ConcurrencyLimiter {
+public:
+    /**
+     * @brief 放行回调：granted 为 false 表示被拒绝（未占用名额）
+     */
+    typedef std::function<void(bool granted)> Starter;
+
+    ConcurrencyLimiter();
+
+    /**
+     * @brief 构造限制器，排队到期由 executor 上的定时器及时拒绝
+     *
+     * @param executor 运行到期定时器的执行器
+     */
+    explicit ConcurrencyLimiter(const boost::asio::any_io_executor& executor);
+
+    /**
+     * @brief 设置策略并把上限复位为初始值
+     *
+     * @param policy 策略（max_limit 为 0 表示不限制）
+     * @param max_wait 排队的最长时间
+     */
+    void configure(const ConcurrencyLimitPolicy& policy, std::chrono::milliseconds max_wait);
+
+    bool enabled() const;
+
+    /**
+     * @brief 申请一个名额
+     */
+    void acquire(Starter start);
+
+    /**
+     * @brief 归还名额并记录一次完成
+     *
+     * @param dropped 是否因网络错误或超时失败
+     * @param rtt 本次调用耗时
+     */
+    void release(bool dropped, std::chrono::steady_clock::duration rtt);
+
+    /**
+     * @brief 归还未使用的名额（不计入统计）
+     */
+    void cancel();
+
+    /**
+     * @brief 当前上限（未启用时为 0）
+     */
+    std::size_t limit() const;
+
+    /**
+     * @brief 等待队列长度
+     */
+    std::size_t queued() const;
+
+private:
+    struct Waiter {
+        Starter start;                                      ///< 放行回调
+        std::chrono::steady_clock::time_point enqueued;     ///< 入队时间
+    };
+
+    void update(bool dropped, double rtt_us);
+    void drain(std::deque<std::pair<Starter, bool>>& ready);
+    void schedule_expiry();
+    void on_expiry(boost::system::error_code ec);
+    static void run(std::deque<std::pair<Starter, bool>>& ready);
+
+    std::atomic<bool> enabled_;                 ///< 是否启用（免锁检查）
+    mutable std::mutex mutex_;                  ///< 保护以下成员
+    ConcurrencyLimitPolicy policy_;             ///< 策略
+    std::chrono::milliseconds max_wait_;        ///< 排队的最长时间
+    double limit_;                              ///< 当前上限（允许小数，按整数部分放行）
+    std::size_t in_flight_;                     ///< 在途数
+    double rtt_long_us_;                        ///< Gradient：延迟的长期平均值（微秒）
+    std::deque<Waiter> queue_;                  ///< 等待队列
+    std::unique_ptr<boost::asio::steady_timer> timer_;  ///< 队首到期定时器（没有执行器时为空，只在锁内操作）
+    bool timer_armed_;                          ///< 定时器是否在等待
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/concurrency_limiter.ipp>
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <jsonrpc/detail/client_session.hpp>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/**
+ * @file connection_pool.hpp
+ * @brief 客户端 HTTP keep-alive 连接池
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 空闲 HTTP 连接池
+ *
+ * 只保存空闲连接：调用方 acquire() 取出独占使用，完成后 release() 归还。
+ * 归还时连接已关闭、池已满的连接直接丢弃；空闲超过 idle_timeout 的连接
+ * 在下一次 acquire()/release() 时淘汰（不使用定时器，不影响 io_context::run() 返回）。
+ * 所有成员函数线程安全。
+ */
+class ConnectionPool {
+public:
+    ConnectionPool();
+
+    /**
+     * @brief 设置最多保留的空闲连接数（0 表示不复用连接）
+     */
+    void set_max_idle(std::size_t count);
+
+    std::size_t max_idle() const;
+
+    /**
+     * @brief 设置空闲连接的最长保留时间
+     */
+    void set_idle_timeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 取出一个仍然可用的空闲连接
+     *
+     * @return 空闲连接；没有可用连接时返回空指针
+     */
+    std::shared_ptr<ClientSession> acquire();
+
+    /**
+     * @brief 归还连接
+     *
+     * @param session 使用完毕的连接（不可再由调用方使用）
+     */
+    void release(std::shared_ptr<ClientSession> session);
+
+    /**
+     * @brief 关闭并丢弃所有空闲连接
+     */
+    void clear();
+
+    /**
+     * @brief 当前空闲连接数
+     */
+    std::size_t idle_count() const;
+
+private:
+    struct IdleConnection {
+        std::shared_ptr<ClientSession> session;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    /**
+     * @brief 淘汰超时的空闲连接（调用方持有 mutex_）
+     */
+    void evict_expired(std::chrono::steady_clock::time_point now);
+
+    mutable std::mutex mutex_;                          ///< 保护以下成员
+    std::deque<IdleConnection> idle_;                   ///< 空闲连接（越靠后越新）
+    std::size_t max_idle_;                              ///< 最多保留的空闲连接数
+    std::chrono::milliseconds idle_timeout_;            ///< 空闲连接最长保留时间
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/connection_pool.ipp>
+#endif
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+
+#ifdef JSONRPC_HAS_COROUTINES
+
+#include <jsonrpc/errors.hpp>
+#include <jsonrpc/detail/method_wrapper.hpp>
+#include <jsonrpc/detail/function_traits.hpp>
+#include <jsonrpc/detail/type_converter.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/json.hpp>
+#include <boost/optional.hpp>
+#include <exception>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file coroutine_wrapper.hpp
+ * @brief 协程方法包装器（C++20，可选）
+ *
+ * 返回 boost::asio::awaitable<R> 的方法在调用方会话的执行器上 co_spawn，
+ * 可以 co_await 定时器、socket 或下游调用而不占用线程。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 判断类型是否为 boost::asio::awaitable<R>
+ */
+template<typename T>
+struct awaitable_traits : std::false_type {};
+
+template<typename R>
+struct awaitable_traits<boost::asio::awaitable<R, boost::asio::any_io_executor>> : std::true_type {
+    typedef R value_type;
+};
+
+/**
+ * @brief 协程方法包装器
+ *
+ * @tparam Func 函数类型，返回 boost::asio::awaitable<R>
+ */
+template<typename Func>
+class CoroutineMethodWrapperImpl : public MethodWrapperBase {
+    typedef typename function_traits<Func>::return_type awaitable_type;
+    typedef typename awaitable_traits<awaitable_type>::value_type R;
+
+public:
+    explicit CoroutineMethodWrapperImpl(Func func)
+        : func_(std::move(func))
+    {}
+
+    bool completes_later() const override {
+        return true;
+    }
+
+    /**
+     * @brief 同步调用（在临时 io_context 上运行协程直到完成）
+     */
+    boost::json::value invoke(const boost::json::value& params) override {
+        std::exception_ptr error;
+        boost::json::value result;
+        async_invoke(params, InvokeContext(), [&](std::exception_ptr e, boost::json::value r) {
+            error = e;
+            result = std::move(r);
+        });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return result;
+    }
+
+    void async_invoke(const boost::json::value& params, const InvokeContext& context,
+                      InvokeHandler handler) override {
+        start(params, context, std::move(handler), typename function_traits<Func>::args_tuple{});
+    }
+
+private:
+    template<typename... Args>
+    void start(const boost::json::value& params, const InvokeContext& context,
+               InvokeHandler handler, std::tuple<Args...>) {
+        // 参数在返回前提取完毕，协程只持有自己的副本
+        boost::optional<std::tuple<Args...>> args;
+        try {
+            args = extract_args<Args...>(params);
+        } catch (...) {
+            handler(std::current_exception(), boost::json::value());
+            return;
+        }
+        spawn(context, std::move(handler), std::move(*args));
+    }
+
+    // 第一个参数为 CallContext：上下文拷贝进协程帧，其余参数从 params 转换
+    template<typename... Args>
+    void start(const boost::json::value& params, const InvokeContext& context,
+               InvokeHandler handler, std::tuple<CallContext, Args...>) {
+        boost::optional<std::tuple<Args...>> args;
+        try {
+            args = extract_args<Args...>(params);
+        } catch (...) {
+            handler(std::current_exception(), boost::json::value());
+            return;
+        }
+        spawn(context, std::move(handler), std::tuple_cat(std::make_tuple(context.call), std::move(*args)));
+    }
+
+    template<typename ArgsTuple>
+    void spawn(const InvokeContext& context, InvokeHandler handler, ArgsTuple args) {
+        if (context.executor) {
+            boost::asio::co_spawn(context.executor, run(func_, std::move(args)), std::move(handler));
+            return;
+        }
+
+        // 没有会话执行器（直接调用注册表）时就地运行到完成
+        boost::asio::io_context io_context;
+        boost::asio::co_spawn(io_context, run(func_, std::move(args)), std::move(handler));
+        io_context.run();
+    }
+
+    // 函数对象拷贝进协程帧，方法被重新注册时正在运行的协程不受影响
+    template<typename ArgsTuple>
+    static boost::asio::awaitable<boost::json::value> run(Func func, ArgsTuple args) {
+        try {
+            if constexpr (std::is_void<R>::value) {
+                co_await std::apply(func, std::move(args));
+                co_return json_converter<void>::to_json();
+            } else {
+                R result = co_await std::apply(func, std::move(args));
+                co_return json_converter<R>::to_json(result);
+            }
+        } catch (const Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            throw Error(ErrorCode::InternalError,
+                std::string("方法执行失败: ") + e.what());
+        }
+    }
+
+    Func func_;
+};
+
+/**
+ * @brief 特化：返回 awaitable 的函数使用协程包装器
+ */
+template<typename Func>
+struct select_method_wrapper<Func, typename std::enable_if<
+    awaitable_traits<typename function_traits<Func>::return_type>::value>::type> {
+    typedef CoroutineMethodWrapperImpl<Func> type;
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+#endif // JSONRPC_HAS_COROUTINES
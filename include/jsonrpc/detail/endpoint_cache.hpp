@@ -0,0 +1,122 @@
+#pragma once
+
+#include <jsonrpc/detail/stream_endpoint.hpp>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @file endpoint_cache.hpp
+ * @brief 客户端 DNS 解析结果缓存
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 按 host:port 缓存解析得到的连接端点
+ *
+ * 同一个 Client 的所有会话（连接池中的 HTTP 连接、多路复用会话、通知发送器）共用一个缓存。
+ * 缓存未命中时在调用方解析并写入缓存；条目超过 TTL 后，下一次查找仍立即返回旧结果，
+ * 同时在后台线程重新解析并替换（同一条目同一时刻只有一个刷新），调用方不会被 DNS 阻塞。
+ * 后台刷新失败时保留旧结果，半个 TTL 后再试。连接失败时调用 invalidate() 丢弃条目，
+ * 下次连接重新解析。Unix 域套接字不经过 DNS，不缓存。所有成员函数线程安全。
+ */
+class EndpointCache : public std::enable_shared_from_this<EndpointCache> {
+public:
+    /**
+     * @param ttl 条目有效期（0 表示不缓存）
+     */
+    explicit EndpointCache(std::chrono::milliseconds ttl);
+
+    void set_ttl(std::chrono::milliseconds ttl);
+
+    std::chrono::milliseconds ttl() const;
+
+    /**
+     * @brief 同步解析（优先使用缓存）
+     *
+     * @throws boost::system::system_error 缓存未命中且解析失败
+     */
+    endpoint_list resolve(boost::asio::ip::tcp::resolver& resolver,
+                          const std::string& host,
+                          const std::string& port);
+
+    /**
+     * @brief 异步解析（优先使用缓存，命中时经 resolver 的执行器回调）
+     */
+    void async_resolve(boost::asio::ip::tcp::resolver& resolver,
+                       const std::string& host,
+                       const std::string& port,
+                       std::function<void(boost::system::error_code, endpoint_list)> handler);
+
+    /**
+     * @brief 丢弃条目（连接失败时调用）
+     */
+    void invalidate(const std::string& host, const std::string& port);
+
+    /**
+     * @brief 缓存的条目数
+     */
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        Entry()
+            : refreshing(false)
+        {}
+
+        endpoint_list endpoints;                                ///< 解析结果
+        std::chrono::steady_clock::time_point resolved_at;      ///< 解析时间
+        bool refreshing;                                        ///< 是否正在后台刷新
+    };
+
+    static std::string make_key(const std::string& host, const std::string& port);
+
+    /**
+     * @brief 查找条目；已过期时返回旧结果并启动后台刷新
+     */
+    bool lookup(const std::string& host, const std::string& port, endpoint_list& out);
+
+    void store(const std::string& key, const endpoint_list& endpoints);
+
+    void refresh_in_background(const std::string& host, const std::string& port);
+
+    void finish_refresh(const std::string& key, bool succeeded, const endpoint_list& endpoints);
+
+    mutable std::mutex mutex_;                                  ///< 保护以下成员
+    std::unordered_map<std::string, Entry> entries_;            ///< host:port -> 条目
+    std::chrono::milliseconds ttl_;                             ///< 条目有效期
+};
+
+/**
+ * @brief 同步解析：cache 为空时直接解析
+ */
+endpoint_list resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                                const std::string& host,
+                                const std::string& port,
+                                const std::shared_ptr<EndpointCache>& cache);
+
+/**
+ * @brief 异步解析：cache 为空时直接解析
+ */
+void async_resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                             const std::string& host,
+                             const std::string& port,
+                             const std::shared_ptr<EndpointCache>& cache,
+                             std::function<void(boost::system::error_code, endpoint_list)> handler);
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/endpoint_cache.ipp>
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <jsonrpc/transport.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file frame_codec.hpp
+ * @brief 原始 TCP 传输的分帧编解码
+ *
+ * 支持 4 字节大端长度前缀与换行分隔（NDJSON）两种格式。
+ * 请求帧可以在帧头携带调用方剩余的等待时间，JSON-RPC 消息本身保持标准格式：
+ * - 长度前缀：长度最高位置 1，其后紧跟 4 字节大端毫秒数，再是负载；
+ * - NDJSON：行首为 "@<毫秒数> "，其后是负载（JSON 文本不会以 '@' 开头）。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 分帧编解码器
+ *
+ * 编码：begin_frame() 与 end_frame() 之间直接把 JSON 写入同一个缓冲区，
+ * 长度前缀在结束时回填，不需要额外拷贝。
+ * 解码：每次从已读数据的开头取出一帧，调用方按 consumed 丢弃已处理的字节。
+ */
+class FrameCodec {
+public:
+    static constexpr std::size_t header_size = 4;                          ///< 长度前缀字节数
+    static constexpr std::size_t max_frame_size = 16 * 1024 * 1024;        ///< 单帧最大长度（字节）
+    static constexpr std::uint32_t timeout_flag = 0x80000000u;             ///< 长度前缀中表示携带等待时间的标志位
+
+    /**
+     * @brief 解码状态
+     */
+    enum class Status {
+        NeedMore,  ///< 数据不足一帧
+        Complete,  ///< 取出了一帧
+        TooLarge   ///< 帧超过 max_frame_size，应关闭连接
+    };
+
+    /**
+     * @brief 解码结果
+     */
+    struct Decoded {
+        Status status;
+        std::size_t payload_offset;  ///< 负载在输入中的起始位置
+        std::size_t payload_size;    ///< 负载长度（NDJSON 空行为 0）
+        std::size_t consumed;        ///< 本帧占用的总字节数
+        std::uint32_t timeout_ms;    ///< 帧头携带的剩余等待时间（毫秒，0 表示未携带）
+    };
+
+    /**
+     * @brief 在 out 末尾开始一帧
+     *
+     * @param transport 传输方式（必须是原始 TCP 传输之一）
+     * @param out 输出缓冲区
+     * @param timeout 调用方剩余的等待时间，非 0 时写入帧头（只用于请求帧）
+     * @return 帧起始位置，传给 end_frame()
+     */
+    static std::size_t begin_frame(Transport transport, std::string& out,
+                                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    /**
+     * @brief 结束一帧：回填长度前缀或追加换行
+     *
+     * @param transport 传输方式
+     * @param out 输出缓冲区
+     * @param frame_start begin_frame() 的返回值
+     */
+    static void end_frame(Transport transport, std::string& out, std::size_t frame_start);
+
+    /**
+     * @brief 从 data 开头解码一帧
+     *
+     * @param transport 传输方式
+     * @param data 已读取的数据
+     * @param size 数据长度
+     * @return 解码结果
+     */
+    static Decoded decode(Transport transport, const char* data, std::size_t size);
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/frame_codec.ipp>
+#endif
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <jsonrpc/types.hpp>
+#include <jsonrpc/transport.hpp>
+#include <jsonrpc/detail/frame_codec.hpp>
+#include <jsonrpc/detail/stream_endpoint.hpp>
+#include <jsonrpc/detail/endpoint_cache.hpp>
+#include <jsonrpc/detail/pending_table.hpp>
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <deque>
+#include <vector>
+
+/**
+ * @file framed_client_session.hpp
+ * @brief 客户端多路复用会话
+ *
+ * 一条连接上同时承载多个请求：原始 TCP 分帧传输按 id 匹配响应，HTTP 传输按流水线顺序匹配。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 客户端多路复用会话
+ *
+ * 两种用法，同一个对象只用其中一种：
+ * - 同步（call / call_batch / notify，仅原始 TCP 传输）：每次调用使用独立连接，阻塞直到完成；
+ * - 异步（async_call / async_notify）：长连接，请求写出后不等待响应即可写出下一个。
+ *   原始 TCP 传输下响应可乱序返回，按 id 匹配回调；HTTP 传输下为 HTTP/1.1 流水线，
+ *   服务端按请求顺序逐个响应，按写出顺序匹配（前一个慢请求会推迟其后的响应）。
+ *   连接在首次调用时建立，断开后下次调用自动重连；没有待读的响应时不保留挂起的读操作，
+ *   因此 io_context::run() 会在所有回调完成后返回。异步状态只在内部 strand 上访问。
+ */
+class FramedClientSession : public std::enable_shared_from_this<FramedClientSession> {
+public:
+    typedef std::function<void(const Response&)> Callback;
+
+    /**
+     * @brief 构造会话
+     *
+     * @param io_context I/O 上下文
+     * @param host 服务器地址（"unix:/path" 表示 Unix 域套接字）
+     * @param port 服务器端口
+     * @param timeout 同步调用的超时时间
+     * @param logger 日志回调
+     * @param transport 传输方式
+     * @param endpoint_cache DNS 解析缓存（为空时每次连接都解析）
+     */
+    FramedClientSession(
+        boost::asio::io_context& io_context,
+        const std::string& host,
+        const std::string& port,
+        std::chrono::milliseconds timeout,
+        std::function<void(const std::string&)> logger,
+        Transport transport,
+        std::shared_ptr<EndpointCache> endpoint_cache = nullptr
+    );
+
+    /**
+     * @brief 同步调用
+     * @throws Error 网络错误或响应无效
+     */
+    Response call(const Request& request);
+
+    /**
+     * @brief 批量同步调用
+     * @throws Error 网络错误或响应无效
+     */
+    std::vector<Response> call_batch(const std::vector<Request>& requests);
+
+    /**
+     * @brief 同步发送通知（写出即返回，忽略错误）
+     */
+    void notify(const Request& request);
+
+    /**
+     * @brief 异步调用（可在任意线程调用）
+     *
+     * @param request 请求对象（id 必须为整数）
+     * @param timeout 本次调用的超时时间
+     * @param callback 完成回调（在 io_context 线程中调用）
+     */
+    void async_call(const Request& request, std::chrono::milliseconds timeout, Callback callback);
+
+    /**
+     * @brief 异步批量调用（仅原始 TCP 传输）
+     *
+     * 所有请求编码为一帧，响应数组中的元素按 id 分别完成各自的回调。
+     *
+     * @param requests 请求列表（id 必须为整数）
+     * @param timeout 本批调用的超时时间
+     * @param callbacks 各请求的完成回调（与 requests 一一对应）
+     */
+    void async_call_batch(const std::vector<Request>& requests,
+                          std::chrono::milliseconds timeout,
+                          std::vector<Callback> callbacks);
+
+    /**
+     * @brief 异步发送通知（写出后即完成，没有回调）
+     */
+    void async_notify(const Request& request);
+
+    /**
+     * @brief 把 JSON 文本编码为一帧追加到 out 末尾（HTTP 传输下为一个完整的 HTTP 请求）
+     *
+     * @param transport 传输方式
+     * @param host 服务器地址（用于 HTTP Host 头）
+     * @param json JSON 文本
+     * @param out 输出缓冲区
+     * @param timeout 调用方剩余的等待时间，非 0 时写入 X-Jsonrpc-Timeout-Ms 头或帧头
+     */
+    static void append_frame(Transport transport, const std::string& host,
+                             const std::string& json, std::string& out,
+                             std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+private:
+    /**
+     * @brief 在途调用
+     */
+    struct PendingCall {
+        Callback callback;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    /**
+     * @brief 将 JSON 文本编码为一帧（HTTP 传输下为一个完整的 HTTP 请求）
+     *
+     * @param timeout 调用方剩余的等待时间（通知传 0）
+     */
+    std::string encode(const std::string& json, std::chrono::milliseconds timeout) const;
+
+    /**
+     * @brief 同步：连接、写出一帧并读取一帧响应
+     */
+    std::string exchange_sync(const std::string& frame, bool expect_reply);
+
+    // ---- 以下在 strand_ 上运行 ----
+
+    void start_call(std::int64_t id, std::chrono::milliseconds timeout, Callback& callback, std::string& frame);
+    void start_batch(std::vector<std::int64_t>& ids, std::chrono::milliseconds timeout,
+                     std::vector<Callback>& callbacks, std::string& frame);
+    void start_notify(std::string& frame);
+    void queue_frame(std::string& frame);
+    void reset_connection();
+    void do_connect();
+    void on_connected();
+    void do_write();
+    void do_read();
+    void on_read(boost::system::error_code ec, std::size_t bytes_transferred);
+    bool awaiting_reply() const;  ///< 是否还有未读的响应（在途调用或 HTTP 流水线中的通知）
+    bool read_frames();
+    bool read_http_responses();
+    void handle_frame(boost::json::string_view payload);
+    Response parse_http_body(std::int64_t id, const std::string& body) const;
+    void handle_http_response(boost::beast::http::response<boost::beast::http::string_body>& response);
+    void complete_by_id(const Response& response);
+    void complete(std::int64_t id, const Response& response);
+    void arm_timer(std::chrono::steady_clock::time_point deadline);
+    void on_timer(boost::system::error_code ec);
+    void fail_all(const std::string& reason);
+
+    void log(const std::string& message) const;
+
+    typedef boost::beast::http::response_parser<boost::beast::http::string_body> response_parser;
+
+    enum : std::int64_t {
+        no_reply_id = INT64_MIN     ///< HTTP 流水线中通知的占位 id
+    };
+
+    enum class State {
+        Disconnected,
+        Connecting,
+        Connected
+    };
+
+    boost::asio::io_context& io_context_;                        ///< I/O 上下文
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;  ///< 异步状态的串行执行器
+    boost::asio::ip::tcp::resolver resolver_;                    ///< DNS 解析器
+    stream_type stream_;                                         ///< 连接流（TCP 或 Unix 域套接字）
+    std::string host_;                                           ///< 服务器地址
+    std::string port_;                                           ///< 服务器端口
+    std::chrono::milliseconds timeout_;                          ///< 同步调用超时时间
+    std::function<void(const std::string&)> logger_;             ///< 日志回调
+    Transport transport_;                                        ///< 分帧方式
+    std::shared_ptr<EndpointCache> endpoint_cache_;              ///< DNS 解析缓存（可为空）
+
+    boost::beast::flat_buffer buffer_;                           ///< 读取缓冲区
+    State state_;                                                ///< 异步连接状态
+    PendingTable<PendingCall> pending_;                          ///< 在途调用（按 id）
+    std::deque<std::int64_t> http_order_;                        ///< HTTP 流水线：已写出请求的 id（按写出顺序）
+    std::unique_ptr<response_parser> http_parser_;               ///< HTTP 流水线：正在解析的响应
+    std::vector<std::string> write_queue_;                       ///< 等待写出的帧
+    bool writing_;                                               ///< 是否有挂起的写操作
+    bool reading_;                                               ///< 是否有挂起的读操作
+    std::uint64_t generation_;                                   ///< 连接代数，每次 reset_connection() 递增
+    boost::asio::steady_timer timer_;                            ///< 超时检查定时器
+    bool timer_armed_;                                           ///< 定时器是否在等待
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/framed_client_session.ipp>
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <jsonrpc/detail/method_registry.hpp>
+#include <jsonrpc/detail/server_session.hpp>
+#include <jsonrpc/detail/frame_codec.hpp>
+#include <jsonrpc/detail/stream_endpoint.hpp>
+#include <jsonrpc/transport.hpp>
+#include <boost/asio.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @file framed_server_session.hpp
+ * @brief 服务端原始 TCP 会话
+ *
+ * 处理长度前缀 / NDJSON 分帧连接上的请求。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 服务端原始 TCP 会话
+ *
+ * 持续读取请求帧，每帧立即交给方法注册表执行，不等待前一个请求完成；
+ * 响应按完成顺序写回（客户端按 id 匹配），排队中的多个响应合并为一次写入。
+ * 读到对端关闭后取消尚未开始的请求，执行中的方法可经 CallContext::cancelled() 得知；
+ * 半关闭（对端 shutdown 写方向）与关闭无法区分，同样取消。
+ * 所有状态只在 socket 的执行器（strand）上访问。
+ */
+class FramedServerSession : public std::enable_shared_from_this<FramedServerSession> {
+public:
+    /**
+     * @brief 构造会话
+     *
+     * @param socket 已接受的连接（TCP 或 Unix 域套接字，移动语义）
+     * @param registry 方法注册表（共享指针）
+     * @param logger 日志回调
+     * @param options 会话配置
+     * @param transport 分帧方式（LengthPrefixed 或 NewlineDelimited）
+     */
+    FramedServerSession(
+        stream_socket socket,
+        std::shared_ptr<MethodRegistry> registry,
+        std::function<void(const std::string&)> logger,
+        SessionOptions options,
+        Transport transport
+    );
+
+    /**
+     * @brief 启动会话
+     */
+    void start();
+
+    /**
+     * @brief 关闭连接，挂起的读写以 operation_aborted 结束
+     *
+     * 不经过执行器，只能在没有线程运行 io_context 时调用（服务器析构）。
+     */
+    void close();
+
+private:
+    /**
+     * @brief 异步读取数据
+     */
+    void do_read();
+
+    /**
+     * @brief 读取完成回调，取出所有完整的帧
+     */
+    void on_read(boost::system::error_code ec, std::size_t bytes_transferred);
+
+    /**
+     * @brief 解析一帧并分派其中的请求
+     *
+     * @param payload 帧负载（JSON 文本），仅在本函数返回前有效
+     * @param timeout 帧头携带的调用方剩余等待时间（0 表示未携带）
+     */
+    void process_frame(boost::json::string_view payload, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 将响应编码为一帧（可在任意线程调用）
+     */
+    std::string encode_response(const Response& response) const;
+
+    /**
+     * @brief 将批量响应编码为一帧（可在任意线程调用）
+     */
+    std::string encode_batch_response(const std::vector<Response>& responses) const;
+
+    /**
+     * @brief 排队一帧待写出（在会话执行器上运行）
+     *
+     * @param frame 已编码的帧（内容被移走）
+     */
+    void send_frame(std::string& frame);
+
+    /**
+     * @brief 将已排队的帧合并写出
+     */
+    void do_write();
+
+    /**
+     * @brief 写入完成回调
+     */
+    void on_write(boost::system::error_code ec);
+
+    void log(const std::string& message) const;
+
+    stream_socket socket_;                                      ///< 连接套接字
+    boost::beast::flat_buffer buffer_;                          ///< 读取缓冲区
+    std::shared_ptr<MethodRegistry> registry_;                  ///< 方法注册表
+    std::function<void(const std::string&)> logger_;            ///< 日志回调
+    SessionOptions options_;                                    ///< 会话配置
+    Transport transport_;                                       ///< 分帧方式
+    std::vector<std::string> write_queue_;                      ///< 等待写出的帧
+    std::vector<std::string> writing_;                          ///< 正在写出的帧
+    bool write_failed_;                                         ///< 写入失败后丢弃后续响应
+    std::shared_ptr<std::atomic<bool>> disconnected_;           ///< 对端已断开（方法经 CallContext 读取）
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/framed_server_session.ipp>
+#endif
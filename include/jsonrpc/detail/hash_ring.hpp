@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file hash_ring.hpp
+ * @brief 分片客户端的一致性哈希环
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 带虚拟节点的一致性哈希环
+ *
+ * 每个节点按 "名称#序号" 在环上放置 virtual_nodes 个点，键顺时针归属遇到的第一个点。
+ * 增删一个节点只移动约 1/N 的键。哈希为 FNV-1a 加 64 位混合，跨平台、跨进程稳定，
+ * 同一组节点在不同客户端上得到相同的路由。构造完成后只读，可在多个线程中同时查找。
+ */
+class HashRing {
+public:
+    /**
+     * @param virtual_nodes 每个节点的虚拟节点数（至少 1）
+     */
+    explicit HashRing(std::size_t virtual_nodes);
+
+    /**
+     * @brief 加入节点
+     *
+     * @param name 节点名称（决定在环上的位置，通常为 "host:port"）
+     * @param index 节点下标（locate() 的返回值）
+     */
+    void add(const std::string& name, std::size_t index);
+
+    /**
+     * @brief 查找键所属节点
+     *
+     * @return 节点下标（环为空时返回 0）
+     */
+    std::size_t locate(const std::string& key) const;
+
+    /**
+     * @brief 稳定的 64 位哈希
+     */
+    static std::uint64_t hash(const std::string& data);
+
+private:
+    std::size_t virtual_nodes_;                                     ///< 每个节点的虚拟节点数
+    std::vector<std::pair<std::uint64_t, std::size_t>> points_;     ///< 环上的点（按哈希值排序）
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/hash_ring.ipp>
+#endif
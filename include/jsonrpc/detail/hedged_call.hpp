@@ -0,0 +1,137 @@
+#pragma once
+
+#include <jsonrpc/retry.hpp>
+#include <jsonrpc/types.hpp>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+/**
+ * @file hedged_call.hpp
+ * @brief 幂等调用的重试与对冲
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 最近成功调用的延迟样本（环形缓冲），用于计算对冲延迟。线程安全。
+ */
+class LatencyWindow {
+public:
+    /**
+     * @param capacity 保留的样本数
+     */
+    explicit LatencyWindow(std::size_t capacity = 1024);
+
+    void record(std::chrono::steady_clock::duration latency);
+
+    /**
+     * @brief 计算延迟分位数
+     *
+     * @param percentile 分位数（0~100）
+     * @param out 结果
+     * @return 样本不足时返回 false
+     */
+    bool percentile(double percentile, std::chrono::steady_clock::duration& out) const;
+
+private:
+    mutable std::mutex mutex_;                  ///< 保护以下成员
+    std::vector<std::int64_t> samples_;         ///< 延迟样本（微秒）
+    std::size_t capacity_;                      ///< 样本上限
+    std::size_t next_;                          ///< 缓冲写满后下一个被覆盖的位置
+};
+
+/**
+ * @brief 一次带重试与对冲的异步调用
+ *
+ * 每一轮先发出请求，delay 内没有响应时再发出副本（每个副本使用新的请求 id，
+ * 最多 max_hedges 个），最先到达的非网络错误响应作为结果，其余副本的响应被丢弃。
+ * 本轮所有副本都以网络错误结束时，按退避策略等待后开始下一轮，直到达到最多尝试次数。
+ * 交给回调的响应 id 恢复为原请求的 id。状态只在内部 strand 上访问，回调也在 strand 上调用。
+ */
+class HedgedCall : public std::enable_shared_from_this<HedgedCall> {
+public:
+    typedef std::function<void(const Response&)> Callback;
+
+    /**
+     * @brief 发送函数：发出一份请求，完成时调用回调（可在任意线程）
+     *
+     * 第二个参数为 true 表示这是对冲副本，应尽量走另一条连接。
+     */
+    typedef std::function<void(const Request&, bool, Callback)> Sender;
+
+    /**
+     * @brief 发起调用
+     *
+     * @param io_context I/O 上下文（定时器与 strand 所在）
+     * @param request 请求
+     * @param retry 重试策略
+     * @param hedge 对冲策略
+     * @param latencies 延迟样本（成功的响应计入）
+     * @param sender 发送函数
+     * @param next_id 为副本与重试生成新的请求 id
+     * @param callback 完成回调（只调用一次）
+     */
+    static void start(boost::asio::io_context& io_context,
+                      const Request& request,
+                      const RetryPolicy& retry,
+                      const HedgePolicy& hedge,
+                      std::shared_ptr<LatencyWindow> latencies,
+                      Sender sender,
+                      std::function<boost::json::value()> next_id,
+                      Callback callback);
+
+    HedgedCall(boost::asio::io_context& io_context,
+               const Request& request,
+               const RetryPolicy& retry,
+               const HedgePolicy& hedge,
+               std::shared_ptr<LatencyWindow> latencies,
+               Sender sender,
+               std::function<boost::json::value()> next_id,
+               Callback callback);
+
+private:
+    // ---- 以下在 strand_ 上运行 ----
+    void begin_round();
+    void launch(bool hedged);
+    void arm_hedge();
+    void on_hedge_timer(boost::system::error_code ec);
+    void on_response(const Response& response, std::size_t round, std::chrono::steady_clock::time_point sent);
+    void on_backoff_timer(boost::system::error_code ec);
+    void finish(const Response& response);
+    std::chrono::milliseconds backoff();
+
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;   ///< 状态的串行执行器
+    boost::asio::steady_timer hedge_timer_;         ///< 对冲延迟
+    boost::asio::steady_timer backoff_timer_;       ///< 重试退避
+    Request request_;                               ///< 原请求
+    RetryPolicy retry_;                             ///< 重试策略
+    HedgePolicy hedge_;                             ///< 对冲策略
+    std::chrono::steady_clock::duration hedge_delay_;   ///< 本次调用的对冲延迟
+    std::shared_ptr<LatencyWindow> latencies_;      ///< 延迟样本
+    Sender sender_;                                 ///< 发送函数
+    std::function<boost::json::value()> next_id_;   ///< 请求 id 生成
+    Callback callback_;                             ///< 完成回调
+    std::size_t attempts_;                          ///< 已开始的轮数
+    std::size_t hedges_;                            ///< 本轮已发出的副本数
+    std::size_t in_flight_;                         ///< 本轮尚未完成的副本数
+    bool finished_;                                 ///< 是否已调用完成回调
+    std::minstd_rand random_;                       ///< 退避抖动
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/hedged_call.ipp>
+#endif
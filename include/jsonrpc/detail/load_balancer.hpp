@@ -0,0 +1,107 @@
+#pragma once
+
+#include <jsonrpc/endpoint.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <vector>
+
+/**
+ * @file load_balancer.hpp
+ * @brief 多端点客户端的负载均衡与异常端点摘除
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 端点选择器
+ *
+ * 记录每个端点的在途请求数、成功调用延迟的 EWMA 与连续网络失败次数。
+ * 连续失败达到阈值的端点被摘除一段时间，期满后重新参与选择；
+ * 重新加入后再失败一次即再次摘除，成功一次则恢复正常。
+ * 所有端点都被摘除时忽略摘除状态，仍在全部端点中选择。所有成员函数线程安全。
+ */
+class LoadBalancer {
+public:
+    /**
+     * @param endpoint_count 端点数量（至少 1）
+     */
+    explicit LoadBalancer(std::size_t endpoint_count);
+
+    void set_policy(LoadBalancePolicy policy);
+
+    LoadBalancePolicy policy() const;
+
+    /**
+     * @brief 设置异常端点摘除
+     *
+     * @param consecutive_failures 连续网络失败多少次后摘除（0 表示不摘除）
+     * @param duration 摘除时长
+     */
+    void set_ejection(std::size_t consecutive_failures, std::chrono::milliseconds duration);
+
+    /**
+     * @brief 选择一个端点并计入一个在途请求
+     *
+     * @return 端点下标
+     */
+    std::size_t acquire();
+
+    /**
+     * @brief 请求完成
+     *
+     * @param index acquire() 返回的下标
+     * @param succeeded 是否成功（服务端返回的 RPC 错误也算成功，只有网络失败算失败）
+     * @param latency 本次调用耗时
+     */
+    void release(std::size_t index, bool succeeded, std::chrono::steady_clock::duration latency);
+
+    /**
+     * @brief 撤销 acquire()：请求未发出（不计入统计）
+     */
+    void cancel(std::size_t index);
+
+    /**
+     * @brief 端点当前状态（endpoint 字段由调用方填写）
+     */
+    EndpointStatus status(std::size_t index) const;
+
+private:
+    struct State {
+        State()
+            : outstanding(0)
+            , latency_us(0.0)
+            , failures(0)
+        {}
+
+        std::size_t outstanding;                                ///< 在途请求数
+        double latency_us;                                      ///< 成功调用延迟的 EWMA（微秒，0 表示尚无样本）
+        std::size_t failures;                                   ///< 连续网络失败次数
+        std::chrono::steady_clock::time_point ejected_until;    ///< 摘除截止时间
+    };
+
+    bool available(const State& state, std::chrono::steady_clock::time_point now) const;
+    double cost(const State& state) const;
+    std::size_t pick(std::chrono::steady_clock::time_point now);
+
+    mutable std::mutex mutex_;                   ///< 保护以下成员
+    std::vector<State> states_;                  ///< 各端点状态
+    LoadBalancePolicy policy_;                   ///< 选择策略
+    std::size_t cursor_;                         ///< 轮询位置（最少在途策略中用于打散平局）
+    std::size_t eject_after_;                    ///< 摘除阈值
+    std::chrono::milliseconds eject_duration_;   ///< 摘除时长
+    std::minstd_rand random_;                    ///< 两选一策略的随机数
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/load_balancer.ipp>
+#endif
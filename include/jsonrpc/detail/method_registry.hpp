@@ -1,15 +1,22 @@
 #pragma once
 
 #include <jsonrpc/detail/method_wrapper.hpp>
+#include <jsonrpc/detail/priority_scheduler.hpp>
+#include <jsonrpc/priority.hpp>
 #include <jsonrpc/types.hpp>
 #include <algorithm>
 #include <atomic>
+#include <exception>
 #include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <boost/optional.hpp>
+#include <functional>
 #include <future>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <utility>
@@ -46,38 +53,191 @@ public:
      */
     void set_batch_concurrency(std::size_t threads);
 
+    /**
+     * @brief 设置只读模式
+     *
+     * 只读模式下禁止注册新方法，方法查找不再加锁，
+     * 供多个事件循环无竞争地共享同一注册表。
+     *
+     * @param read_only 是否只读
+     */
+    void set_read_only(bool read_only);
+
+    /**
+     * @brief 是否处于只读模式
+     */
+    bool is_read_only() const;
+
+    /**
+     * @brief 设置方法的默认优先级（未设置的方法为 Priority::Normal）
+     *
+     * 调用方在请求中指定的优先级（InvokeContext::priority）优先于此设置。
+     *
+     * @param name 方法名（可以在注册方法之前设置）
+     * @param priority 优先级
+     * @throws std::logic_error 注册表处于只读模式
+     */
+    void set_method_priority(const std::string& name, Priority priority);
+
+    /**
+     * @brief 设置线程池的优先级调度策略
+     *
+     * @param policy 调度策略
+     */
+    void set_priority_scheduling(const SchedulingPolicy& policy);
+
     /**
      * @brief 注册方法
      *
+     * 启用协程（JSONRPC_HAS_COROUTINES）时，返回 boost::asio::awaitable<R> 的函数
+     * 会在调用方会话的执行器上以协程方式运行。
+     *
      * @tparam Func 函数类型
      * @param name 方法名
      * @param func 函数对象
+     * @throws std::logic_error 注册表处于只读模式
      */
     template<typename Func>
     void register_method(const std::string& name, Func&& func);
 
+    /**
+     * @brief 注册异步方法
+     *
+     * @tparam Func 函数类型，签名为 void(Args..., Responder<R>)
+     * @param name 方法名
+     * @param func 函数对象
+     * @throws std::logic_error 注册表处于只读模式
+     */
+    template<typename Func>
+    void register_async_method(const std::string& name, Func&& func);
+
     /**
      * @brief 调用方法
      *
+     * 方法抛出的任何异常都会转换为错误响应，不会向外传播。
+     *
      * @param request 请求对象
      * @return 响应对象
      */
     Response invoke(const Request& request);
 
     /**
-     * @brief 批量调用方法
+     * @brief 在当前线程启动方法调用
+     *
+     * 同步方法在返回前回调 handler；异步方法在 Responder 回复时回调，
+     * 可能发生在任意线程。通知请求同样会回调（响应内容可忽略）。
+     * 已超过 context.call 截止时间的请求不执行，以 DeadlineExceeded 回调；
+     * context.call 已取消（客户端断开）时带 id 的请求同样不执行，通知照常执行。
+     * request 只需在本函数返回前保持有效。
+     *
+     * @param request 请求对象
+     * @param handler 完成回调（恰好调用一次）
+     * @param context 调用上下文
+     */
+    void begin_invoke(const Request& request, std::function<void(Response)> handler,
+                      const InvokeContext& context = InvokeContext());
+
+    /**
+     * @brief 在线程池中调用单个方法（异步）
+     *
+     * 只投递一次任务，不经过批量路径的槽位收集；任务按请求的优先级排队。同步方法的 handler 在线程池中调用，
+     * 异步方法的 handler 在 Responder 回复的线程调用；通知请求同样会回调（响应内容可忽略）。
+     * request 必须保持有效直到 handler 被调用。
+     *
+     * @param request 请求对象
+     * @param handler 完成回调
+     * @param context 调用上下文
+     */
+    void async_invoke(const Request& request, std::function<void(Response)> handler,
+                      const InvokeContext& context = InvokeContext());
+
+    /**
+     * @brief 批量调用方法（阻塞等待全部完成）
      *
      * @param requests 请求对象列表
      * @return 响应对象列表
      */
     std::vector<Response> invoke_batch(const std::vector<Request>& requests);
 
+    /**
+     * @brief 批量调用方法（异步）
+     *
+     * 将请求按各自方法的优先级投递到批量线程池后立即返回，全部请求执行完毕后在线程池中
+     * 调用 handler，响应顺序与请求顺序一致（通知不产生响应）。
+     * requests 必须保持有效直到 handler 被调用。
+     *
+     * @param requests 请求对象列表
+     * @param handler 完成回调
+     * @param context 调用上下文
+     */
+    void async_invoke_batch(const std::vector<Request>& requests,
+                            std::function<void(std::vector<Response>)> handler,
+                            const InvokeContext& context = InvokeContext());
+
+    /**
+     * @brief 等待已投递到线程池的调用全部完成
+     *
+     * 用于服务器析构前确保没有任务仍持有会话；线程池会在下次调用时重建。
+     * 不能在线程池线程中调用。
+     */
+    void drain();
+
+    /**
+     * @brief 停止接受新的调用
+     *
+     * 之后 begin_invoke() 直接以错误完成，线程池被 drain() 回收后不再重建。用于服务器析构。
+     */
+    void shutdown();
+
+    /**
+     * @brief 已开始执行、尚未回复的异步调用数（异步方法与协程方法）
+     *
+     * 响应回调返回后才计为完成。
+     */
+    std::size_t outstanding() const;
+
+    /**
+     * @brief 放弃所有尚未回复的异步调用
+     *
+     * 释放它们的响应回调（及其持有的会话），之后迟到的回复直接丢弃。
+     * 返回时没有响应回调仍在执行，调用方可以安全地销毁会话所在的 io_context。
+     */
+    void abandon_outstanding();
+
 private:
+    /**
+     * @brief 一个尚未回复的异步调用
+     */
+    struct PendingReply {
+        std::mutex mutex;                                           ///< 串行化回复与放弃
+        std::function<void(Response)> handler;                      ///< 响应回调，回复或放弃后为空
+        std::list<std::weak_ptr<PendingReply>>::iterator position;  ///< 在 ReplyTracker::pending 中的位置
+    };
+
+    /**
+     * @brief 尚未回复的异步调用表
+     *
+     * 完成回调只持有它的弱引用：注册表销毁后，迟到的回复不再访问注册表。
+     */
+    struct ReplyTracker {
+        std::mutex mutex;                                   ///< 保护 pending
+        std::list<std::weak_ptr<PendingReply>> pending;     ///< 尚未回复的调用
+    };
+
     std::shared_ptr<boost::asio::thread_pool> get_batch_pool();
+    void add_method(const std::string& name, std::shared_ptr<MethodWrapperBase> wrapper);
+    MethodWrapperBase* find_method(const std::string& name, std::shared_ptr<MethodWrapperBase>& holder);
+    Priority priority_of(const Request& request, const InvokeContext& context);
+    static Response make_error_response(std::exception_ptr error, const boost::json::value& id);
 
     std::map<std::string, std::shared_ptr<MethodWrapperBase>> methods_;
-    std::mutex mutex_;  ///< 保护 methods_ 的并发访问
+    std::map<std::string, Priority> priorities_;  ///< 方法的默认优先级
+    std::mutex mutex_;  ///< 保护 methods_ 和 priorities_ 的并发访问
+    std::atomic<bool> read_only_;  ///< 只读模式下 methods_ 和 priorities_ 不再变化，查找无需加锁
+    std::atomic<bool> shut_down_;  ///< shutdown() 之后不再接受新的调用
+    std::shared_ptr<ReplyTracker> replies_;  ///< 尚未回复的异步调用
     std::size_t batch_thread_count_;
+    PriorityScheduler scheduler_;  ///< 线程池任务的优先级队列（先于线程池构造、后于其析构）
     std::shared_ptr<boost::asio::thread_pool> batch_pool_;
     std::mutex pool_mutex_;
 };
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <jsonrpc/call_context.hpp>
 #include <jsonrpc/errors.hpp>
+#include <jsonrpc/responder.hpp>
+#include <jsonrpc/priority.hpp>
 #include <jsonrpc/detail/function_traits.hpp>
 #include <jsonrpc/detail/type_converter.hpp>
 #include <jsonrpc/detail/index_sequence.hpp>
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/json.hpp>
+#include <boost/optional.hpp>
+#include <exception>
+#include <future>
 #include <memory>
 
 /**
@@ -19,6 +26,24 @@
 namespace jsonrpc {
 namespace detail {
 
+/**
+ * @brief 单次调用的上下文
+ */
+struct InvokeContext {
+    boost::asio::any_io_executor executor;  ///< 发起调用的会话执行器（协程方法在其上运行），可为空
+    CallContext call;                       ///< 传给方法的上下文（调用方的截止时间）
+    boost::optional<Priority> priority;     ///< 调用方指定的优先级（为空时使用方法的默认优先级）
+};
+
+/**
+ * @brief 判断方法的参数列表（已 decay 的 tuple）是否以 CallContext 开头
+ */
+template<typename ArgsTuple>
+struct takes_call_context : std::false_type {};
+
+template<typename... Args>
+struct takes_call_context<std::tuple<CallContext, Args...>> : std::true_type {};
+
 /**
  * @brief 方法包装器基类
  *
@@ -35,6 +60,36 @@ public:
      * @throws Error 如果参数不匹配或方法执行失败
      */
     virtual boost::json::value invoke(const boost::json::value& params) = 0;
+
+    /**
+     * @brief 异步调用方法
+     *
+     * 默认实现同步调用 invoke() 后立即回调；异步方法在 Responder 回复时回调，
+     * 可能发生在任意线程。params 只在本函数返回前使用。
+     *
+     * @param params JSON 参数
+     * @param context 调用上下文
+     * @param handler 完成回调（恰好调用一次）
+     */
+    virtual void async_invoke(const boost::json::value& params, const InvokeContext& context,
+                              InvokeHandler handler) {
+        (void)context;
+        boost::json::value result;
+        try {
+            result = invoke(params);
+        } catch (...) {
+            handler(std::current_exception(), boost::json::value());
+            return;
+        }
+        handler(std::exception_ptr(), std::move(result));
+    }
+
+    /**
+     * @brief async_invoke() 返回后是否仍可能回调（异步方法、协程方法）
+     */
+    virtual bool completes_later() const {
+        return false;
+    }
 };
 
 // ============================================================================
@@ -177,21 +232,43 @@ public:
     {}
 
     boost::json::value invoke(const boost::json::value& params) override {
-        return invoke_impl(params, typename function_traits<Func>::args_tuple{});
+        return invoke_impl(params, CallContext(), typename function_traits<Func>::args_tuple{});
+    }
+
+    void async_invoke(const boost::json::value& params, const InvokeContext& context,
+                      InvokeHandler handler) override {
+        boost::json::value result;
+        try {
+            result = invoke_impl(params, context.call, typename function_traits<Func>::args_tuple{});
+        } catch (...) {
+            handler(std::current_exception(), boost::json::value());
+            return;
+        }
+        handler(std::exception_ptr(), std::move(result));
     }
 
 private:
     template<typename... Args>
-    boost::json::value invoke_impl(const boost::json::value& params, std::tuple<Args...>) {
-        typedef typename function_traits<Func>::return_type R;
-
-        try {
-            // 提取参数
-            auto args_tuple = extract_args<Args...>(params);
+    boost::json::value invoke_impl(const boost::json::value& params, const CallContext&, std::tuple<Args...>) {
+        return guarded([&]() {
+            return invoke_and_convert<typename function_traits<Func>::return_type>(extract_args<Args...>(params));
+        });
+    }
 
-            // 调用函数并转换返回值
-            return invoke_and_convert<R>(std::move(args_tuple));
+    // 第一个参数为 CallContext：不从 params 转换，直接传入本次调用的上下文
+    template<typename... Args>
+    boost::json::value invoke_impl(const boost::json::value& params, const CallContext& call,
+                                   std::tuple<CallContext, Args...>) {
+        return guarded([&]() {
+            return invoke_and_convert<typename function_traits<Func>::return_type>(
+                std::tuple_cat(std::tuple<const CallContext&>(call), extract_args<Args...>(params)));
+        });
+    }
 
+    template<typename Body>
+    static boost::json::value guarded(Body body) {
+        try {
+            return body();
         } catch (const Error&) {
             throw;
         } catch (const std::exception& e) {
@@ -219,5 +296,106 @@ private:
     Func func_;
 };
 
+// ============================================================================
+// 异步方法包装器（最后一个参数为 Responder<R>）
+// ============================================================================
+
+/**
+ * @brief 异步方法包装器
+ *
+ * 从 params 提取除 Responder 之外的参数，调用函数后立即返回，
+ * 结果由函数在之后通过 Responder 回复。第一个参数可以是 CallContext。
+ *
+ * @tparam Func 函数类型，签名为 void([CallContext,] Args..., Responder<R>)
+ */
+template<typename Func>
+class AsyncMethodWrapperImpl : public MethodWrapperBase {
+    typedef typename function_traits<Func>::args_tuple args_tuple;
+    static constexpr size_t arity = std::tuple_size<args_tuple>::value;
+    static_assert(arity >= 1, "异步方法的最后一个参数必须是 Responder<R>");
+    typedef typename std::tuple_element<arity - 1, args_tuple>::type responder_type;
+    static_assert(is_responder<responder_type>::value, "异步方法的最后一个参数必须是 Responder<R>");
+    typedef takes_call_context<args_tuple> takes_context;
+    static constexpr size_t first_param = takes_context::value ? 1 : 0;  ///< 第一个从 params 转换的参数位置
+
+public:
+    explicit AsyncMethodWrapperImpl(Func func)
+        : func_(std::move(func))
+    {}
+
+    bool completes_later() const override {
+        return true;
+    }
+
+    /**
+     * @brief 同步调用（阻塞等待 Responder 回复）
+     *
+     * 仅用于同步调用路径，服务端会话走 async_invoke()。
+     */
+    boost::json::value invoke(const boost::json::value& params) override {
+        auto promise = std::make_shared<std::promise<boost::json::value>>();
+        auto future = promise->get_future();
+        async_invoke(params, InvokeContext(), [promise](std::exception_ptr error, boost::json::value result) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(result));
+            }
+        });
+        return future.get();
+    }
+
+    void async_invoke(const boost::json::value& params, const InvokeContext& context,
+                      InvokeHandler handler) override {
+        start(params, context.call, std::move(handler), make_index_sequence<arity - 1 - first_param>{});
+    }
+
+private:
+    template<size_t... Is>
+    void start(const boost::json::value& params, const CallContext& call, InvokeHandler handler,
+               index_sequence<Is...>) {
+        auto state = std::make_shared<ResponderState>(std::move(handler));
+
+        try {
+            auto args = extract_args<typename std::tuple_element<Is + first_param, args_tuple>::type...>(params);
+            call_with_context(call, takes_context(),
+                              std::get<Is>(std::move(args))..., responder_type(state));
+        } catch (...) {
+            // 参数错误或函数在回复前同步抛出异常；已回复时忽略
+            state->complete(std::current_exception(), boost::json::value());
+        }
+    }
+
+    template<typename... Args>
+    void call_with_context(const CallContext&, std::false_type, Args&&... args) {
+        func_(std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void call_with_context(const CallContext& call, std::true_type, Args&&... args) {
+        func_(call, std::forward<Args>(args)...);
+    }
+
+    Func func_;
+};
+
+// ============================================================================
+// 包装器选择
+// ============================================================================
+
+/**
+ * @brief 根据函数类型选择方法包装器
+ *
+ * 默认使用 MethodWrapperImpl；启用协程时返回 awaitable 的函数使用协程包装器。
+ */
+template<typename Func, typename Enable = void>
+struct select_method_wrapper {
+    typedef MethodWrapperImpl<Func> type;
+};
+
 } // namespace detail
 } // namespace jsonrpc
+
+#ifdef JSONRPC_HAS_COROUTINES
+#include <jsonrpc/detail/coroutine_wrapper.hpp>
+#endif
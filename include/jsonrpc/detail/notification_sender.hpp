@@ -0,0 +1,125 @@
+#pragma once
+
+#include <jsonrpc/transport.hpp>
+#include <jsonrpc/detail/stream_endpoint.hpp>
+#include <jsonrpc/detail/endpoint_cache.hpp>
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file notification_sender.hpp
+ * @brief 客户端通知的后台发送队列
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 通知后台发送器
+ *
+ * notify() 只在调用方线程序列化并入队，由后台线程通过一条长连接发送：
+ * 后台线程每次取走队列中的全部通知，一次写出（HTTP 传输下为流水线请求，
+ * 随后读取对应数量的 204 响应；原始 TCP 传输下服务端不回写）。
+ * 队列有容量上限，满时按 NotifyOverflow 阻塞或丢弃。
+ * 通知尽力送达：网络错误时丢弃当前这一批并记录日志，下一批自动重连。
+ * 析构时发送完队列中剩余的通知再退出。
+ */
+class NotificationSender {
+public:
+    /**
+     * @brief 构造发送器（后台线程在首次入队时启动）
+     *
+     * @param host 服务器地址（"unix:/path" 表示 Unix 域套接字）
+     * @param port 服务器端口
+     * @param timeout 连接与读写的超时时间
+     * @param logger 日志回调（在后台线程中调用）
+     * @param transport 传输方式
+     * @param capacity 队列容量
+     * @param policy 队列满时的处理方式
+     * @param endpoint_cache DNS 解析缓存（可为空）
+     */
+    NotificationSender(const std::string& host,
+                       const std::string& port,
+                       std::chrono::milliseconds timeout,
+                       std::function<void(const std::string&)> logger,
+                       Transport transport,
+                       std::size_t capacity,
+                       NotifyOverflow policy,
+                       std::shared_ptr<EndpointCache> endpoint_cache = nullptr);
+
+    ~NotificationSender();
+
+    NotificationSender(const NotificationSender&) = delete;
+    NotificationSender& operator=(const NotificationSender&) = delete;
+
+    /**
+     * @brief 入队一条已序列化的通知
+     *
+     * @param json 通知的 JSON 文本
+     * @return 被丢弃时返回 false
+     */
+    bool push(std::string json);
+
+    /**
+     * @brief 阻塞直到已入队的通知全部写出（或因网络错误被丢弃）
+     */
+    void flush();
+
+    /**
+     * @brief 因队列已满而丢弃的通知数
+     */
+    std::size_t dropped() const;
+
+private:
+    void run();
+    void send(const std::vector<std::string>& batch);
+    void write_batch(const std::string& wire, std::size_t count);
+    void connect();
+    void close();
+    void log(const std::string& message) const;
+
+    std::string host_;                                   ///< 服务器地址
+    std::string port_;                                   ///< 服务器端口
+    std::chrono::milliseconds timeout_;                  ///< 连接与读写超时
+    std::function<void(const std::string&)> logger_;     ///< 日志回调
+    Transport transport_;                                ///< 传输方式
+    std::size_t capacity_;                               ///< 队列容量
+    NotifyOverflow policy_;                              ///< 队列满时的处理方式
+    std::shared_ptr<EndpointCache> endpoint_cache_;      ///< DNS 解析缓存（可为空）
+
+    boost::asio::io_context io_context_;                 ///< 后台线程的 I/O 上下文（仅用于同步读写）
+    boost::asio::ip::tcp::resolver resolver_;            ///< DNS 解析器
+    stream_type stream_;                                 ///< 长连接
+    bool connected_;                                     ///< 连接是否已建立（仅后台线程访问）
+
+    mutable std::mutex mutex_;                           ///< 保护以下队列状态
+    std::condition_variable not_empty_;                  ///< 有新通知或正在停止
+    std::condition_variable not_full_;                   ///< 队列有空位
+    std::condition_variable drained_;                    ///< 队列已清空且没有正在发送的批次
+    std::deque<std::string> queue_;                      ///< 待发送的通知
+    bool sending_;                                       ///< 后台线程是否正在发送一批
+    bool stopping_;                                      ///< 是否正在析构
+    std::atomic<std::size_t> dropped_;                   ///< 丢弃计数
+    std::thread thread_;                                 ///< 后台发送线程
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/notification_sender.ipp>
+#endif
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @file pending_table.hpp
+ * @brief 在途调用表
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 按请求 id 索引的在途调用表
+ *
+ * 开放寻址（线性探测）哈希表，容量为 2 的幂，槽位为 id 的低位。
+ * 客户端的请求 id 单调递增，同时在途的 id 几乎不会落到同一槽位，
+ * 查找与删除通常只访问一个槽位；所有槽位连续存放，没有逐节点的内存分配。
+ * 删除时回移后续槽位，不留墓碑。非线程安全。
+ *
+ * @tparam T 每个调用保存的数据（须可默认构造、可移动）
+ */
+template<typename T>
+class PendingTable {
+public:
+    PendingTable()
+        : size_(0)
+    {}
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief 插入调用，id 已存在时覆盖
+     */
+    void insert(std::int64_t id, T value) {
+        // 负载因子不超过 1/2
+        if ((size_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+
+        std::size_t index = find_slot(id);
+        if (!slots_[index].used) {
+            slots_[index].used = true;
+            slots_[index].id = id;
+            ++size_;
+        }
+        slots_[index].value = std::move(value);
+    }
+
+    /**
+     * @brief 取出并删除调用
+     *
+     * @param id 请求 id
+     * @param out 取出的数据
+     * @return id 不存在（已完成或已超时）时返回 false
+     */
+    bool take(std::int64_t id, T& out) {
+        if (size_ == 0) {
+            return false;
+        }
+
+        std::size_t index = find_slot(id);
+        if (!slots_[index].used) {
+            return false;
+        }
+
+        out = std::move(slots_[index].value);
+        erase_at(index);
+        return true;
+    }
+
+    /**
+     * @brief 遍历所有调用
+     *
+     * @param fn 回调 void(std::int64_t id, T& value)，不得修改表
+     */
+    template<typename Fn>
+    void for_each(Fn fn) {
+        for (auto& slot : slots_) {
+            if (slot.used) {
+                fn(slot.id, slot.value);
+            }
+        }
+    }
+
+    /**
+     * @brief 取出所有调用并清空表（保留容量）
+     */
+    std::vector<std::pair<std::int64_t, T>> drain() {
+        std::vector<std::pair<std::int64_t, T>> entries;
+        entries.reserve(size_);
+        for (auto& slot : slots_) {
+            if (slot.used) {
+                entries.emplace_back(slot.id, std::move(slot.value));
+                slot.used = false;
+                slot.value = T();
+            }
+        }
+        size_ = 0;
+        return entries;
+    }
+
+private:
+    struct Slot {
+        Slot()
+            : used(false)
+            , id(0)
+        {}
+
+        bool used;
+        std::int64_t id;
+        T value;
+    };
+
+    std::size_t home(std::int64_t id) const {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(id)) & (slots_.size() - 1);
+    }
+
+    /**
+     * @brief 返回 id 所在槽位；不存在时返回应插入的空槽位
+     */
+    std::size_t find_slot(std::int64_t id) const {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t index = home(id);
+        while (slots_[index].used && slots_[index].id != id) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void erase_at(std::size_t index) {
+        std::size_t mask = slots_.size() - 1;
+        slots_[index].used = false;
+        slots_[index].value = T();
+        --size_;
+
+        // 回移：把后续探测链上能放回更靠前位置的元素移入空位
+        std::size_t hole = index;
+        std::size_t next = (hole + 1) & mask;
+        while (slots_[next].used) {
+            std::size_t desired = home(slots_[next].id);
+            // desired 不在 (hole, next] 区间内时可以移入 hole
+            bool movable = (hole <= next)
+                ? (desired <= hole || desired > next)
+                : (desired <= hole && desired > next);
+            if (movable) {
+                slots_[hole] = std::move(slots_[next]);
+                slots_[next].used = false;
+                slots_[next].value = T();
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.resize(old.empty() ? 16 : old.size() * 2);
+        size_ = 0;
+        for (auto& slot : old) {
+            if (slot.used) {
+                std::size_t index = find_slot(slot.id);
+                slots_[index].used = true;
+                slots_[index].id = slot.id;
+                slots_[index].value = std::move(slot.value);
+                ++size_;
+            }
+        }
+    }
+
+    std::vector<Slot> slots_;   ///< 槽位（容量为 2 的幂）
+    std::size_t size_;          ///< 在途调用数
+};
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <jsonrpc/priority.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+/**
+ * @file priority_scheduler.hpp
+ * @brief 线程池任务的优先级队列
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 线程池前的优先级调度器
+ *
+ * post() 把任务放入对应优先级的队列，并向线程池投递一个只负责“取出一个任务执行”
+ * 的占位任务；占位任务运行时才按策略选出要执行的任务，因此线程池仍然是 FIFO，
+ * 而实际执行顺序由优先级决定。线程池的 join() 语义不变：所有占位任务执行完毕时
+ * 队列必然为空。所有成员函数线程安全；调度器必须比投递过占位任务的线程池活得更久。
+ */
+class PriorityScheduler {
+public:
+    typedef std::function<void()> Task;
+
+    PriorityScheduler();
+
+    /**
+     * @brief 设置调度策略（对已排队的任务立即生效）
+     */
+    void set_policy(const SchedulingPolicy& policy);
+
+    /**
+     * @brief 排队一个任务并唤醒线程池中的一个工作线程
+     *
+     * @param pool 执行任务的线程池
+     * @param priority 优先级
+     * @param task 任务
+     */
+    void post(boost::asio::thread_pool& pool, Priority priority, Task task);
+
+    /**
+     * @brief 丢弃所有排队的任务（线程池被 stop() 后调用，与占位任务一起作废）
+     */
+    void clear();
+
+    /**
+     * @brief 某个优先级正在排队的任务数
+     */
+    std::size_t queued(Priority priority) const;
+
+private:
+    static constexpr std::size_t class_count = 3;
+
+    /**
+     * @brief 按策略取出下一个任务（队列全空时返回空任务）
+     */
+    Task next();
+
+    mutable std::mutex mutex_;                  ///< 保护以下成员
+    SchedulingPolicy policy_;                   ///< 调度策略
+    std::deque<Task> queues_[class_count];      ///< 各优先级的 FIFO 队列（下标为 Priority 的值）
+    long long credits_[class_count];            ///< WeightedFair：平滑加权轮转的当前值
+};
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/priority_scheduler.ipp>
+#endif
@@ -18,11 +18,29 @@
 namespace jsonrpc {
 namespace detail {
 
+/**
+ * @brief 调用方剩余等待时间（毫秒）的 HTTP 头
+ */
+constexpr const char* timeout_header = "X-Jsonrpc-Timeout-Ms";
+
+/**
+ * @brief 调用方指定优先级（high / normal / low）的 HTTP 头
+ */
+constexpr const char* priority_header = "X-Jsonrpc-Priority";
+
 /**
  * @brief JSON-RPC 2.0 协议处理器
  *
  * 提供静态方法用于处理 JSON-RPC 2.0 协议的各个方面。
  */
+/**
+ * @brief 请求解析结果
+ */
+struct ParsedRequests {
+    std::vector<Request> requests;  ///< 请求列表（单个请求时只有 1 个元素）
+    bool is_batch;                  ///< 请求体是否为批量请求（JSON array）
+};
+
 class Protocol {
 public:
     /**
@@ -31,26 +49,71 @@ public:
      * 支持单个请求和批量请求（JSON array）。
      *
      * @param json_str JSON 字符串
+     * @param sp 解析结果（含请求 params/id）使用的存储，默认堆
      * @return 请求对象列表（单个请求返回包含 1 个元素的 vector）
      * @throws Error 如果解析失败或请求无效
      */
-    static std::vector<Request> parse_request(const std::string& json_str);
+    static std::vector<Request> parse_request(const std::string& json_str,
+                                              boost::json::storage_ptr sp = {});
+
+    /**
+     * @brief 解析 JSON-RPC 请求并返回是否为批量请求
+     *
+     * 只解析一次，直接读取调用方的缓冲区（如 HTTP 请求体），不拷贝。
+     *
+     * @param json_str JSON 文本
+     * @param sp 解析结果（含请求 params/id）使用的存储，默认堆
+     * @return 请求列表与批量标志
+     * @throws Error 如果解析失败或请求无效
+     */
+    static ParsedRequests parse_requests(boost::json::string_view json_str,
+                                         boost::json::storage_ptr sp = {});
 
     /**
      * @brief 序列化单个响应
      *
      * @param response 响应对象
+     * @param sp 中间 JSON 对象使用的存储，默认堆
      * @return JSON 字符串
      */
-    static std::string serialize_response(const Response& response);
+    static std::string serialize_response(const Response& response,
+                                          boost::json::storage_ptr sp = {});
 
     /**
      * @brief 序列化批量响应
      *
      * @param responses 响应对象列表
+     * @param sp 中间 JSON 对象使用的存储，默认堆
      * @return JSON 字符串（JSON array）
      */
-    static std::string serialize_batch_response(const std::vector<Response>& responses);
+    static std::string serialize_batch_response(const std::vector<Response>& responses,
+                                                boost::json::storage_ptr sp = {});
+
+    /**
+     * @brief 将单个响应直接序列化追加到 out
+     *
+     * 不构造中间 JSON 对象，result/id 由 boost::json::serializer 分块写入 out。
+     *
+     * @param response 响应对象
+     * @param out 输出缓冲区（如 HTTP 响应体），内容追加在末尾
+     */
+    static void write_response(const Response& response, std::string& out);
+
+    /**
+     * @brief 将批量响应直接序列化追加到 out（JSON array）
+     *
+     * @param responses 响应对象列表
+     * @param out 输出缓冲区，内容追加在末尾
+     */
+    static void write_batch_response(const std::vector<Response>& responses, std::string& out);
+
+    /**
+     * @brief 将 JSON 值分块序列化追加到 out
+     *
+     * @param jv JSON 值
+     * @param out 输出缓冲区
+     */
+    static void append_json(const boost::json::value& jv, std::string& out);
 
     /**
      * @brief 验证 JSON-RPC 版本字段
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <boost/json.hpp>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @file request_arena.hpp
+ * @brief 单次请求的 JSON 内存区
+ *
+ * 请求解析、参数与响应对象都从同一个 monotonic_resource 分配，
+ * 写回完成后一次性释放，避免每个请求数十次 malloc/free。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 单次请求的 JSON 内存区
+ *
+ * 每个会话持有一个，初始缓冲区随会话复用；超出部分向堆申请，reset() 时归还。
+ * monotonic_resource 不是线程安全的，只能在会话执行器上分配，
+ * 线程池中的方法只读取其中的值，需要保留的值应拷贝到默认存储。
+ */
+class RequestArena {
+public:
+    static constexpr std::size_t default_buffer_size = 4096;  ///< 初始缓冲区大小（字节）
+
+    explicit RequestArena(std::size_t buffer_size = default_buffer_size)
+        : buffer_(new unsigned char[buffer_size])
+        , resource_(buffer_.get(), buffer_size)
+    {}
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * @brief 获取指向本内存区的 storage_ptr（不持有所有权）
+     */
+    boost::json::storage_ptr storage() {
+        return boost::json::storage_ptr(&resource_);
+    }
+
+    /**
+     * @brief 释放本次请求分配的全部内存
+     *
+     * 调用前必须销毁所有使用本内存区的 JSON 值。
+     */
+    void reset() {
+        resource_.release();
+    }
+
+private:
+    std::unique_ptr<unsigned char[]> buffer_;
+    boost::json::monotonic_resource resource_;
+};
+
+} // namespace detail
+} // namespace jsonrpc
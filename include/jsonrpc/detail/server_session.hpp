@@ -1,11 +1,15 @@
 #pragma once
 
 #include <jsonrpc/detail/method_registry.hpp>
+#include <jsonrpc/detail/request_arena.hpp>
+#include <jsonrpc/detail/stream_endpoint.hpp>
 #include <boost/asio.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
+#include <atomic>
 #include <memory>
 #include <functional>
+#include <vector>
 
 /**
  * @file server_session.hpp
@@ -19,6 +23,17 @@
 namespace jsonrpc {
 namespace detail {
 
+/**
+ * @brief 会话行为配置（由 Server 在创建会话时传入）
+ */
+struct SessionOptions {
+    SessionOptions()
+        : inline_single_requests(false)
+    {}
+
+    bool inline_single_requests;  ///< 单个请求直接在 I/O 线程执行，不经过线程池
+};
+
 /**
  * @brief 服务端会话
  *
@@ -30,13 +45,16 @@ public:
     /**
      * @brief 构造会话
      *
-     * @param socket TCP socket（移动语义）
+     * @param socket 已接受的连接（TCP 或 Unix 域套接字，移动语义）
      * @param registry 方法注册表（共享指针）
+     * @param logger 日志回调
+     * @param options 会话配置
      */
     ServerSession(
-        boost::asio::ip::tcp::socket socket,
+        stream_socket socket,
         std::shared_ptr<MethodRegistry> registry,
-        std::function<void(const std::string&)> logger
+        std::function<void(const std::string&)> logger,
+        SessionOptions options = SessionOptions()
     );
 
     /**
@@ -46,6 +64,13 @@ public:
      */
     void start();
 
+    /**
+     * @brief 关闭连接，挂起的读写以 operation_aborted 结束
+     *
+     * 不经过执行器，只能在没有线程运行 io_context 时调用（服务器析构）。
+     */
+    void close();
+
 private:
     /**
      * @brief 异步读取 HTTP 请求
@@ -63,10 +88,42 @@ private:
     /**
      * @brief 处理请求
      *
-     * 解析 JSON-RPC 请求，调用方法，构造 HTTP 响应。
+     * 校验并解析 JSON-RPC 请求，将方法调用交给批量线程池后立即返回事件循环。
      */
     void process_request();
 
+    /**
+     * @brief 方法执行期间监视连接，对端关闭时置位 disconnected_
+     *
+     * 对端半关闭（shutdown 写方向）同样读到 0 字节，按关闭处理。
+     */
+    void watch_peer();
+
+    /**
+     * @brief 监视的连接可读（对端关闭、出错或发来了下一个请求）
+     */
+    void on_peer_event(boost::system::error_code ec);
+
+    /**
+     * @brief 方法调用全部完成（在会话执行器上运行）
+     *
+     * 根据 responses_ 构造 HTTP 响应并写回；对端已断开时丢弃结果。
+     */
+    void on_dispatch_complete();
+
+    /**
+     * @brief 清空 res_，保留响应体已分配的容量供下一次序列化复用
+     */
+    void reset_response();
+
+    /**
+     * @brief 构造纯文本错误响应并写回
+     *
+     * @param status HTTP 状态码
+     * @param message 响应正文
+     */
+    void write_http_error(boost::beast::http::status status, const std::string& message);
+
     /**
      * @brief 异步写入 HTTP 响应
      */
@@ -88,12 +145,20 @@ private:
 
     void log(const std::string& message) const;
 
-    boost::beast::tcp_stream stream_;                                           ///< TCP 流
+    static constexpr std::size_t max_retained_body_capacity = 64 * 1024;      ///< 响应体复用容量上限（字节）
+
+    stream_type stream_;                                                        ///< 连接流（TCP 或 Unix 域套接字）
     boost::beast::flat_buffer buffer_;                                          ///< 读取缓冲区
     boost::beast::http::request<boost::beast::http::string_body> req_;          ///< HTTP 请求
     boost::beast::http::response<boost::beast::http::string_body> res_;         ///< HTTP 响应
     std::shared_ptr<MethodRegistry> registry_;                                  ///< 方法注册表
     std::function<void(const std::string&)> logger_;                            ///< 日志回调
+    SessionOptions options_;                                                    ///< 会话配置
+    RequestArena arena_;                                                        ///< 单次请求的 JSON 内存区（写回完成后重置）
+    std::vector<Request> requests_;                                             ///< 正在执行的请求（调用完成前保持有效）
+    std::vector<Response> responses_;                                           ///< 调用结果（由线程池写入后投递回会话执行器）
+    bool is_batch_;                                                             ///< 当前请求是否为批量请求
+    std::shared_ptr<std::atomic<bool>> disconnected_;                           ///< 对端已断开（方法经 CallContext 读取）
 };
 
 } // namespace detail
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @file stream_endpoint.hpp
+ * @brief TCP / Unix 域套接字的统一连接端点
+ *
+ * 会话统一使用 generic::stream_protocol 套接字，TCP 与 Unix 域套接字共用同一套读写代码。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+typedef boost::asio::generic::stream_protocol stream_protocol;              ///< 与地址族无关的流协议
+typedef stream_protocol::socket stream_socket;                              ///< 会话使用的套接字
+typedef boost::beast::basic_stream<stream_protocol> stream_type;            ///< 带超时的会话流
+typedef std::vector<stream_protocol::endpoint> endpoint_list;               ///< 候选连接端点
+
+/**
+ * @brief 空闲连接的探测结果
+ */
+enum class SocketProbe {
+    Idle,       ///< 连接正常，没有待读数据
+    Readable,   ///< 连接正常，有待读数据
+    Closed      ///< 对端已关闭或连接出错
+};
+
+/**
+ * @brief 非阻塞地探测连接状态（MSG_PEEK，不消耗数据）
+ */
+SocketProbe probe_socket(stream_socket& socket);
+
+/**
+ * @brief HTTP Host 头（Unix 域套接字使用 "localhost"）
+ */
+std::string http_host_header(const std::string& host);
+
+/**
+ * @brief 判断地址是否为 Unix 域套接字（"unix:/path/to/socket"）
+ */
+bool is_unix_endpoint(const std::string& host);
+
+/**
+ * @brief 取出 "unix:" 之后的套接字路径
+ */
+std::string unix_socket_path(const std::string& host);
+
+/**
+ * @brief 同步解析连接端点
+ *
+ * Unix 域套接字直接返回路径对应的端点，不经过 DNS；其余地址按 TCP 解析。
+ *
+ * @throws boost::system::system_error 解析失败，或平台不支持 Unix 域套接字
+ */
+endpoint_list resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                                const std::string& host,
+                                const std::string& port);
+
+/**
+ * @brief 异步解析连接端点
+ *
+ * @param handler 完成回调（在 resolver 的执行器上调用）
+ */
+void async_resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                             const std::string& host,
+                             const std::string& port,
+                             std::function<void(boost::system::error_code, endpoint_list)> handler);
+
+} // namespace detail
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/stream_endpoint.ipp>
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <jsonrpc/errors.hpp>
+#include <string>
+
+/**
+ * @file transport_error.hpp
+ * @brief 客户端网络错误
+ *
+ * 连接、读写失败与超时在客户端统一表示为 InternalError，消息以 "网络错误: " 开头，
+ * 与服务端返回的 InternalError 区分开（负载均衡据此统计端点的失败）。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 构造网络错误
+ *
+ * @param reason 错误原因
+ */
+inline Error transport_error(const std::string& reason) {
+    return Error(ErrorCode::InternalError, "网络错误: " + reason);
+}
+
+/**
+ * @brief 判断错误是否由客户端的网络失败产生
+ */
+inline bool is_transport_error(const Error& error) {
+    static const std::string prefix("网络错误: ");
+    return error.code() == ErrorCode::InternalError &&
+           error.message().compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace detail
+} // namespace jsonrpc
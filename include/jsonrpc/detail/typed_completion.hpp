@@ -0,0 +1,153 @@
+#pragma once
+
+#include <jsonrpc/errors.hpp>
+#include <jsonrpc/types.hpp>
+#include <jsonrpc/detail/type_converter.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/system/error_code.hpp>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file typed_completion.hpp
+ * @brief 基于完成令牌的异步调用：把 Response 转换为带类型的完成结果
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 判断 T 是否为 async_call() 原有的 Response 回调
+ *
+ * use_future_t 带有 operator()（用于包装函数），也能转换为 std::function，需排除。
+ */
+template<typename T>
+struct is_use_future : std::false_type {};
+
+template<typename Allocator>
+struct is_use_future<boost::asio::use_future_t<Allocator>> : std::true_type {};
+
+template<typename T>
+struct is_response_callback
+    : std::integral_constant<bool,
+          std::is_convertible<T, std::function<void(const Response&)>>::value &&
+          !is_use_future<typename std::decay<T>::type>::value>
+{};
+
+/**
+ * @brief 返回值类型对应的完成签名与结果提取
+ *
+ * - Result：void(error_code, Result)，RPC 错误与类型不匹配以 jsonrpc::error_category() 的 error_code 报告；
+ * - Response：void(error_code, Response)，error_code 恒为成功，错误保留在 Response 中；
+ * - void：void(error_code)。
+ */
+template<typename Result>
+struct call_completion {
+    typedef void signature(boost::system::error_code, Result);
+
+    template<typename Handler>
+    static void invoke(Handler& handler, const Response& response) {
+        if (response.is_error()) {
+            handler(make_error_code(response.error().code()), Result());
+            return;
+        }
+
+        Result value = Result();
+        try {
+            value = json_converter<Result>::from_json(response.result());
+        } catch (const Error& e) {
+            handler(make_error_code(e.code()), Result());
+            return;
+        }
+        handler(boost::system::error_code(), std::move(value));
+    }
+};
+
+template<>
+struct call_completion<Response> {
+    typedef void signature(boost::system::error_code, Response);
+
+    template<typename Handler>
+    static void invoke(Handler& handler, const Response& response) {
+        handler(boost::system::error_code(), response);
+    }
+};
+
+template<>
+struct call_completion<void> {
+    typedef void signature(boost::system::error_code);
+
+    template<typename Handler>
+    static void invoke(Handler& handler, const Response& response) {
+        handler(response.is_error() ? make_error_code(response.error().code())
+                                    : boost::system::error_code());
+    }
+};
+
+/**
+ * @brief 完成令牌生成的处理器与客户端内部回调之间的适配
+ *
+ * 处理器保存在一个共享状态中（客户端内部以 std::function 传递回调，
+ * 处理器本身可能只能移动），并持有其关联执行器上的工作计数，
+ * 使 use_awaitable 等所在的 io_context 在调用完成前不会退出。
+ * 结果在处理器的关联执行器上交付（未关联时为客户端的 io_context）。
+ *
+ * @tparam Result 返回值类型
+ * @tparam Handler 处理器类型
+ */
+template<typename Result, typename Handler>
+class TypedCompletion {
+public:
+    typedef typename boost::asio::associated_executor<
+        Handler, boost::asio::io_context::executor_type>::type executor_type;
+
+    TypedCompletion(Handler handler, const boost::asio::io_context::executor_type& fallback)
+        : handler_(std::move(handler))
+        , work_(boost::asio::get_associated_executor(handler_, fallback))
+    {}
+
+    /**
+     * @brief 包装为客户端内部的响应回调
+     */
+    static std::function<void(const Response&)> wrap(Handler handler,
+                                                     const boost::asio::io_context::executor_type& fallback)
+    {
+        auto state = std::make_shared<TypedCompletion>(std::move(handler), fallback);
+        return [state](const Response& response) {
+            state->complete(response);
+        };
+    }
+
+private:
+    /**
+     * @brief 在处理器执行器上调用的一次性任务
+     */
+    struct Invoker {
+        Handler handler;
+        Response response;
+
+        void operator()() {
+            call_completion<Result>::invoke(handler, response);
+        }
+    };
+
+    void complete(const Response& response) {
+        executor_type executor = work_.get_executor();
+        boost::asio::dispatch(executor, Invoker{std::move(handler_), response});
+        work_.reset();
+    }
+
+    Handler handler_;                                            ///< 完成处理器
+    boost::asio::executor_work_guard<executor_type> work_;       ///< 处理器执行器上的工作计数
+};
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * @file endpoint.hpp
+ * @brief 多服务端客户端的端点与负载均衡策略
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 服务端端点
+ */
+struct Endpoint {
+    std::string host;       ///< 服务器地址（"unix:/path" 表示 Unix 域套接字）
+    unsigned short port;    ///< 服务器端口（Unix 域套接字时忽略）
+};
+
+/**
+ * @brief 多端点客户端选择端点的策略
+ */
+enum class LoadBalancePolicy {
+    RoundRobin,         ///< 轮询
+    LeastOutstanding,   ///< 在途请求最少的端点（默认）
+    PowerOfTwoChoices   ///< 随机取两个端点，选在途请求数 × 延迟 EWMA 较小者
+};
+
+/**
+ * @brief 端点的运行状态（用于观测）
+ */
+struct EndpointStatus {
+    Endpoint endpoint;                      ///< 端点
+    std::size_t outstanding;                ///< 在途请求数
+    std::chrono::microseconds latency;      ///< 成功调用延迟的 EWMA（尚无样本时为 0）
+    std::size_t consecutive_failures;       ///< 连续网络失败次数
+    bool ejected;                           ///< 是否因连续失败被暂时摘除
+    std::size_t concurrency_limit;          ///< 当前自适应并发上限（未启用时为 0）
+    std::size_t queued;                     ///< 等待并发名额的调用数
+};
+
+} // namespace jsonrpc
@@ -2,8 +2,10 @@
 
 #include <jsonrpc/config.hpp>
 #include <boost/json.hpp>
+#include <boost/system/error_code.hpp>
 #include <exception>
 #include <string>
+#include <type_traits>
 
 namespace jsonrpc {
 
@@ -16,7 +18,9 @@ enum class ErrorCode : int {
     MethodNotFound = -32601,  ///< 方法未找到
     InvalidParams = -32602,   ///< 无效的参数
     InternalError = -32603,   ///< 内部错误
-    ServerError = -32000      ///< 服务端错误（-32000 到 -32099）
+    ServerError = -32000,     ///< 服务端错误（-32000 到 -32099）
+    Overloaded = -32001,      ///< 客户端并发上限已满，调用未发出
+    DeadlineExceeded = -32002 ///< 开始执行前已超过调用方的截止时间，方法未执行
 };
 
 /**
@@ -119,4 +123,55 @@ private:
     std::string what_str_;
 };
 
+/**
+ * @brief JSON-RPC 错误码对应的 boost::system 错误类别
+ *
+ * 供基于完成令牌的异步接口把 RPC 错误作为 error_code 交给 Asio
+ * （use_future 抛出 system_error，yield_context 写入 ec，use_awaitable 抛出异常）。
+ */
+class ErrorCategory : public boost::system::error_category {
+public:
+    const char* name() const noexcept override {
+        return "jsonrpc";
+    }
+
+    std::string message(int code) const override {
+        switch (static_cast<ErrorCode>(code)) {
+        case ErrorCode::ParseError:     return "Parse error";
+        case ErrorCode::InvalidRequest: return "Invalid Request";
+        case ErrorCode::MethodNotFound: return "Method not found";
+        case ErrorCode::InvalidParams:  return "Invalid params";
+        case ErrorCode::InternalError:  return "Internal error";
+        case ErrorCode::Overloaded:     return "Overloaded";
+        case ErrorCode::DeadlineExceeded: return "Deadline exceeded";
+        default:
+            return (code <= -32000 && code >= -32099) ? "Server error" : "Application error";
+        }
+    }
+};
+
+/**
+ * @brief 获取 JSON-RPC 错误类别单例
+ */
+inline const boost::system::error_category& error_category() {
+    static const ErrorCategory category;
+    return category;
+}
+
+/**
+ * @brief 由 JSON-RPC 错误码构造 error_code
+ */
+inline boost::system::error_code make_error_code(ErrorCode code) {
+    return boost::system::error_code(static_cast<int>(code), error_category());
+}
+
 } // namespace jsonrpc
+
+namespace boost {
+namespace system {
+
+template<>
+struct is_error_code_enum<jsonrpc::ErrorCode> : std::true_type {};
+
+} // namespace system
+} // namespace boost
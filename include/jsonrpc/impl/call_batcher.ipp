@@ -0,0 +1,116 @@
+#pragma once
+
+#include <jsonrpc/detail/call_batcher.hpp>
+#include <jsonrpc/detail/pending_table.hpp>
+#include <jsonrpc/errors.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造函数
+// ============================================================================
+
+inline CallBatcher::CallBatcher(boost::asio::io_context& io_context,
+                                std::size_t max_batch,
+                                std::chrono::milliseconds max_delay,
+                                Sender sender)
+    : strand_(boost::asio::make_strand(io_context))
+    , timer_(io_context)
+    , max_batch_(max_batch)
+    , max_delay_(max_delay)
+    , sender_(std::move(sender))
+    , timer_armed_(false)
+{
+}
+
+// ============================================================================
+// 加入请求
+// ============================================================================
+
+inline void CallBatcher::add(const Request& request, Callback callback) {
+    boost::asio::post(strand_, std::bind(&CallBatcher::enqueue, shared_from_this(),
+                                         request, std::move(callback)));
+}
+
+inline void CallBatcher::enqueue(Request& request, Callback& callback) {
+    requests_.push_back(std::move(request));
+    callbacks_.push_back(std::move(callback));
+
+    if (requests_.size() >= max_batch_) {
+        flush();
+        return;
+    }
+
+    // 第一个请求开始计时
+    if (!timer_armed_) {
+        timer_armed_ = true;
+        auto self = shared_from_this();
+        timer_.expires_after(max_delay_);
+        timer_.async_wait(boost::asio::bind_executor(strand_,
+            [self](boost::system::error_code ec) {
+                self->on_timer(ec);
+            }
+        ));
+    }
+}
+
+inline void CallBatcher::on_timer(boost::system::error_code ec) {
+    if (ec == boost::asio::error::operation_aborted) {
+        return;
+    }
+    timer_armed_ = false;
+    flush();
+}
+
+inline void CallBatcher::flush() {
+    if (timer_armed_) {
+        timer_armed_ = false;
+        timer_.cancel();
+    }
+    if (requests_.empty()) {
+        return;
+    }
+
+    std::vector<Request> requests;
+    std::vector<Callback> callbacks;
+    requests.swap(requests_);
+    callbacks.swap(callbacks_);
+    requests_.reserve(max_batch_);
+    callbacks_.reserve(max_batch_);
+
+    sender_(requests, callbacks);
+}
+
+// ============================================================================
+// 分发批量响应
+// ============================================================================
+
+inline void fan_out_responses(const std::vector<std::int64_t>& ids,
+                              std::vector<CallBatcher::Callback>& callbacks,
+                              const std::vector<Response>& responses)
+{
+    PendingTable<std::size_t> index;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        index.insert(ids[i], i);
+    }
+
+    std::vector<bool> answered(ids.size(), false);
+    for (const auto& response : responses) {
+        std::size_t position = 0;
+        if (response.id().is_int64() && index.take(response.id().as_int64(), position)) {
+            answered[position] = true;
+            callbacks[position](response);
+        }
+    }
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (!answered[i]) {
+            Error error(ErrorCode::InternalError, "批量响应中缺少该请求的结果");
+            callbacks[i](Response(error, boost::json::value(ids[i])));
+        }
+    }
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -1,12 +1,28 @@
 #pragma once
 
 #include <jsonrpc/client.hpp>
+#include <jsonrpc/detail/call_batcher.hpp>
 #include <jsonrpc/detail/client_session.hpp>
+#include <jsonrpc/detail/concurrency_limiter.hpp>
+#include <jsonrpc/detail/connection_pool.hpp>
+#include <jsonrpc/detail/endpoint_cache.hpp>
+#include <jsonrpc/detail/framed_client_session.hpp>
+#include <jsonrpc/detail/hedged_call.hpp>
+#include <jsonrpc/detail/load_balancer.hpp>
+#include <jsonrpc/detail/notification_sender.hpp>
 #include <jsonrpc/detail/protocol.hpp>
+#include <jsonrpc/detail/transport_error.hpp>
 #include <jsonrpc/detail/type_converter.hpp>
 #include <boost/asio.hpp>
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
 
 namespace jsonrpc {
 
@@ -16,18 +32,58 @@ namespace jsonrpc {
 
 class Client::Impl {
 public:
+    /**
+     * @brief 每个服务端端点的连接资源
+     */
+    struct Backend {
+        Backend(const Endpoint& target, boost::asio::io_context& io_context)
+            : endpoint(target)
+            , host(target.host)
+            , port(std::to_string(target.port))
+            , limiter(io_context.get_executor())
+        {}
+
+        Endpoint endpoint;                                          ///< 端点
+        std::string host;                                           ///< 服务器地址
+        std::string port;                                           ///< 服务器端口
+        detail::ConnectionPool pool;                                ///< HTTP keep-alive 空闲连接
+        std::shared_ptr<detail::FramedClientSession> framed;        ///< 异步调用共用的多路复用会话（framed_mutex_ 保护）
+        std::shared_ptr<detail::NotificationSender> notifier;       ///< 通知后台发送器（framed_mutex_ 保护）
+        detail::ConcurrencyLimiter limiter;                         ///< 自适应并发上限（排队到期由 io_context 上的定时器拒绝）
+    };
+
     /**
      * @brief 构造 Impl
-     * @param host 服务器地址
-     * @param port 服务器端口
+     * @param endpoints 服务端端点（至少一个）
      */
-    Impl(const std::string& host, unsigned short port)
+    explicit Impl(const std::vector<Endpoint>& endpoints)
         : io_context_()
-        , host_(host)
-        , port_(std::to_string(port))
         , timeout_(std::chrono::seconds(30))  // 默认 30 秒超时
         , next_id_(1)
+        , endpoint_cache_(std::make_shared<detail::EndpointCache>(std::chrono::seconds(30)))
+        , transport_(Transport::Http)
+        , pipelining_(false)
+        , batch_size_(0)
+        , batch_delay_(0)
+        , notify_capacity_(1024)
+        , notify_policy_(NotifyOverflow::Block)
+        , dropped_before_(0)
+        , io_thread_count_(0)
+        , latencies_(std::make_shared<detail::LatencyWindow>())
+        , balancer_(endpoints.size())
     {
+        hedge_.max_hedges = 0;  // 默认不对冲
+        limit_policy_.max_limit = 0;  // 默认不限制并发
+        if (endpoints.empty()) {
+            throw std::invalid_argument("客户端至少需要一个服务端端点");
+        }
+        for (const auto& endpoint : endpoints) {
+            backends_.emplace_back(new Backend(endpoint, io_context_));
+        }
+    }
+
+    ~Impl() {
+        stop_io_threads();
     }
 
     /**
@@ -37,26 +93,326 @@ public:
         return io_context_;
     }
 
+    /**
+     * @brief 上一次 run() 处理完所有任务后 io_context 处于停止状态，再次运行前复位
+     *
+     * 长连接会话跨多次 run() 使用，否则后续的 run() 会立即返回。
+     */
+    void restart_if_stopped() {
+        if (io_context_.stopped()) {
+            io_context_.restart();
+        }
+    }
+
+    /**
+     * @brief 启动或停止内部 I/O 线程
+     */
+    void set_io_threads(std::size_t count) {
+        if (io_context_.get_executor().running_in_this_thread()) {
+            throw std::logic_error("不能在客户端的 I/O 线程中调整 I/O 线程数");
+        }
+
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        stop_io_threads_locked();
+        if (count == 0) {
+            return;
+        }
+
+        restart_if_stopped();
+        io_work_.reset(new work_guard_type(io_context_.get_executor()));
+        for (std::size_t i = 0; i < count; ++i) {
+            io_threads_.emplace_back([this]() {
+                io_context_.run();
+            });
+        }
+        io_thread_count_ = count;
+    }
+
+    std::size_t io_threads() const {
+        return io_thread_count_.load();
+    }
+
+    /**
+     * @brief 启用内部 I/O 线程时禁止调用方再运行事件循环
+     */
+    void ensure_caller_driven() const {
+        if (io_thread_count_.load() != 0) {
+            throw std::logic_error("客户端已启用内部 I/O 线程，不能再调用 run()/poll()");
+        }
+    }
+
+    /**
+     * @brief 停止内部 I/O 线程（等待在途的异步调用完成或超时）
+     */
+    void stop_io_threads() {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        stop_io_threads_locked();
+    }
+
     /**
      * @brief 设置超时时间
      */
     void set_timeout(std::chrono::milliseconds timeout) {
-        timeout_ = timeout;
+        {
+            std::lock_guard<std::mutex> lock(framed_mutex_);
+            timeout_ = timeout;
+            // 多路复用会话的同步调用与超时定时器沿用旧的超时时间，丢弃后按需重建（在途调用照常完成）
+            reset_framed_sessions();
+        }
+        // 已建立的连接沿用旧的超时时间，丢弃后按新配置重建
+        for (auto& backend : backends_) {
+            backend->pool.clear();
+        }
+        reset_notifiers();
+        apply_concurrency_limit();
+    }
+
+    /**
+     * @brief 设置各端点连接池的空闲连接上限
+     */
+    void set_max_idle_connections(std::size_t count) {
+        for (auto& backend : backends_) {
+            backend->pool.set_max_idle(count);
+        }
+    }
+
+    /**
+     * @brief 设置各端点连接池的空闲超时
+     */
+    void set_idle_timeout(std::chrono::milliseconds timeout) {
+        for (auto& backend : backends_) {
+            backend->pool.set_idle_timeout(timeout);
+        }
+    }
+
+    /**
+     * @brief 所有端点的空闲连接数
+     */
+    std::size_t idle_connections() const {
+        std::size_t count = 0;
+        for (const auto& backend : backends_) {
+            count += backend->pool.idle_count();
+        }
+        return count;
+    }
+
+    /**
+     * @brief 为每个端点预先建立 HTTP 连接放入连接池
+     */
+    void preconnect(std::size_t count) {
+        for (auto& backend : backends_) {
+            std::vector<std::shared_ptr<detail::ClientSession>> sessions;
+            for (std::size_t i = 0; i < count; ++i) {
+                auto session = create_session(*backend);
+                session->connect();
+                sessions.push_back(std::move(session));
+            }
+            for (auto& session : sessions) {
+                backend->pool.release(std::move(session));
+            }
+        }
+    }
+
+    /**
+     * @brief 获取 DNS 解析缓存
+     */
+    detail::EndpointCache& endpoint_cache() {
+        return *endpoint_cache_;
+    }
+
+    /**
+     * @brief 获取负载均衡器
+     */
+    detail::LoadBalancer& balancer() {
+        return balancer_;
+    }
+
+    /**
+     * @brief 各端点的运行状态
+     */
+    std::vector<EndpointStatus> endpoint_status() const {
+        std::vector<EndpointStatus> result;
+        result.reserve(backends_.size());
+        for (std::size_t i = 0; i < backends_.size(); ++i) {
+            EndpointStatus status = balancer_.status(i);
+            status.endpoint = backends_[i]->endpoint;
+            status.concurrency_limit = backends_[i]->limiter.limit();
+            status.queued = backends_[i]->limiter.queued();
+            result.push_back(status);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 设置传输方式
+     */
+    void set_transport(Transport transport) {
+        {
+            std::lock_guard<std::mutex> lock(framed_mutex_);
+            transport_ = transport;
+            reset_framed_sessions();
+        }
+        reset_notifiers();
+    }
+
+    Transport transport() const {
+        return transport_;
+    }
+
+    /**
+     * @brief 设置 HTTP 异步调用是否使用流水线
+     */
+    void set_pipelining(bool enable) {
+        std::lock_guard<std::mutex> lock(framed_mutex_);
+        pipelining_ = enable;
+        reset_framed_sessions();
+    }
+
+    bool pipelining() const {
+        return pipelining_;
+    }
+
+    /**
+     * @brief 设置自动合批
+     */
+    void set_auto_batching(std::size_t max_batch, std::chrono::milliseconds max_delay) {
+        std::lock_guard<std::mutex> lock(framed_mutex_);
+        batch_size_ = max_batch;
+        batch_delay_ = max_delay;
+        batcher_.reset();
+    }
+
+    /**
+     * @brief 获取合批器（未启用时返回空指针）
+     */
+    std::shared_ptr<detail::CallBatcher> batcher() {
+        std::lock_guard<std::mutex> lock(framed_mutex_);
+        if (batch_size_ <= 1) {
+            return nullptr;
+        }
+        if (!batcher_) {
+            batcher_ = std::make_shared<detail::CallBatcher>(
+                io_context_, batch_size_, batch_delay_,
+                [this](std::vector<Request>& requests, std::vector<detail::CallBatcher::Callback>& callbacks) {
+                    send_batch(requests, callbacks);
+                });
+        }
+        return batcher_;
+    }
+
+    /**
+     * @brief 设置通知队列
+     */
+    void set_notify_queue(std::size_t capacity, NotifyOverflow policy) {
+        {
+            std::lock_guard<std::mutex> lock(framed_mutex_);
+            notify_capacity_ = capacity;
+            notify_policy_ = policy;
+        }
+        reset_notifiers();
+    }
+
+    /**
+     * @brief 获取端点的通知发送器（队列容量为 0 时返回空指针）
+     */
+    std::shared_ptr<detail::NotificationSender> notifier(Backend& backend) {
+        std::lock_guard<std::mutex> lock(framed_mutex_);
+        if (notify_capacity_ == 0) {
+            return nullptr;
+        }
+        if (!backend.notifier) {
+            backend.notifier = std::make_shared<detail::NotificationSender>(
+                backend.host, backend.port, timeout_, logger_, transport_,
+                notify_capacity_, notify_policy_, endpoint_cache_);
+        }
+        return backend.notifier;
+    }
+
+    /**
+     * @brief 丢弃当前通知发送器（析构时发送完已入队的通知），下次通知按新配置重建
+     */
+    void reset_notifiers() {
+        std::vector<std::shared_ptr<detail::NotificationSender>> old;
+        {
+            std::lock_guard<std::mutex> lock(framed_mutex_);
+            for (auto& backend : backends_) {
+                if (backend->notifier) {
+                    old.push_back(std::move(backend->notifier));
+                    backend->notifier.reset();
+                }
+            }
+        }
+        for (const auto& sender : old) {
+            dropped_before_ += sender->dropped();
+        }
+        // old 在锁外析构，等待后台线程发送完毕不阻塞其他调用
+    }
+
+    void flush_notifications() {
+        for (const auto& sender : current_notifiers()) {
+            sender->flush();
+        }
+    }
+
+    std::size_t dropped_notifications() {
+        std::size_t dropped = dropped_before_.load();
+        for (const auto& sender : current_notifiers()) {
+            dropped += sender->dropped();
+        }
+        return dropped;
+    }
+
+    /**
+     * @brief 取出一个 HTTP 会话：优先复用端点连接池中的空闲连接
+     */
+    std::shared_ptr<detail::ClientSession> acquire_session(Backend& backend) {
+        auto session = backend.pool.acquire();
+        if (!session) {
+            session = create_session(backend);
+        }
+        return session;
     }
 
     /**
      * @brief 创建会话
      */
-    std::shared_ptr<detail::ClientSession> create_session() {
+    std::shared_ptr<detail::ClientSession> create_session(const Backend& backend) {
         return std::make_shared<detail::ClientSession>(
             io_context_,
-            host_,
-            port_,
+            backend.host,
+            backend.port,
+            timeout_,
+            logger_,
+            endpoint_cache_
+        );
+    }
+
+    /**
+     * @brief 创建多路复用会话（原始 TCP 同步调用每次一个；异步调用共用一个）
+     */
+    std::shared_ptr<detail::FramedClientSession> create_framed_session(const Backend& backend) {
+        return std::make_shared<detail::FramedClientSession>(
+            io_context_,
+            backend.host,
+            backend.port,
             timeout_,
-            logger_
+            logger_,
+            transport_,
+            endpoint_cache_
         );
     }
 
+    /**
+     * @brief 获取端点上异步调用共用的多路复用长连接会话（原始 TCP 或 HTTP 流水线）
+     */
+    std::shared_ptr<detail::FramedClientSession> framed_session(Backend& backend) {
+        std::lock_guard<std::mutex> lock(framed_mutex_);
+        if (!backend.framed) {
+            backend.framed = create_framed_session(backend);
+        }
+        return backend.framed;
+    }
+
     /**
      * @brief 生成唯一请求 ID
      */
@@ -68,16 +424,35 @@ public:
      * @brief 同步调用
      */
     Response call(const Request& request) {
-        auto session = create_session();
-        return session->call(request);
+        RetryPolicy retry;
+        HedgePolicy hedge;
+        if (resilient(request.method(), retry, hedge)) {
+            return call_hedged(request, retry, hedge);
+        }
+        return tracked_call([this, &request](Backend& backend) -> Response {
+            if (transport_ != Transport::Http) {
+                return create_framed_session(backend)->call(request);
+            }
+            auto session = acquire_session(backend);
+            Response response = session->call(request);
+            backend.pool.release(std::move(session));
+            return response;
+        });
     }
 
     /**
      * @brief 批量同步调用
      */
     std::vector<Response> call_batch(const std::vector<Request>& requests) {
-        auto session = create_session();
-        return session->call_batch(requests);
+        return tracked_call([this, &requests](Backend& backend) -> std::vector<Response> {
+            if (transport_ != Transport::Http) {
+                return create_framed_session(backend)->call_batch(requests);
+            }
+            auto session = acquire_session(backend);
+            std::vector<Response> responses = session->call_batch(requests);
+            backend.pool.release(std::move(session));
+            return responses;
+        });
     }
 
     /**
@@ -86,29 +461,491 @@ public:
     void async_call(const Request& request,
                    std::function<void(const Response&)> callback)
     {
-        auto session = create_session();
-        session->async_call(request, callback);
+        RetryPolicy retry;
+        HedgePolicy hedge;
+        if (resilient(request.method(), retry, hedge)) {
+            start_hedged(request, retry, hedge, std::move(callback));
+            return;
+        }
+        auto batch = batcher();
+        if (batch) {
+            batch->add(request, std::move(callback));
+            return;
+        }
+        send_call(request, std::move(callback));
+    }
+
+    /**
+     * @brief 立即发送一个异步调用
+     *
+     * @param hedged 对冲副本：HTTP 流水线模式下改走连接池中的独立连接，避免排在原请求之后
+     */
+    void send_call(const Request& request,
+                   std::function<void(const Response&)> callback,
+                   bool hedged = false)
+    {
+        std::size_t index = balancer_.acquire();
+        if (!backends_[index]->limiter.enabled()) {
+            dispatch_call(index, request, track(index, std::move(callback), false), hedged);
+            return;
+        }
+
+        admit(index,
+            [this, index, request, callback, hedged](bool limited) {
+                dispatch_call(index, request, track(index, callback, limited), hedged);
+            },
+            [this, request, callback]() {
+                boost::asio::post(io_context_, std::bind(callback, overloaded(request.id())));
+            });
+    }
+
+    /**
+     * @brief 在选中的端点上发出一个异步调用（callback 已由 track() 包装）
+     */
+    void dispatch_call(std::size_t index,
+                       const Request& request,
+                       std::function<void(const Response&)> callback,
+                       bool hedged)
+    {
+        Backend& backend = *backends_[index];
+        if (transport_ != Transport::Http || (pipelining_ && !hedged)) {
+            framed_session(backend)->async_call(request, timeout_, std::move(callback));
+            return;
+        }
+        auto session = acquire_session(backend);
+        Backend* owner = &backend;
+        session->async_call(request, [owner, session, callback](const Response& response) {
+            // 先归还连接，回调中发起的下一次调用即可复用
+            owner->pool.release(session);
+            callback(response);
+        });
+    }
+
+    /**
+     * @brief 发送合批后的请求（整批发往同一个端点）
+     *
+     * 原始 TCP 传输在多路复用连接上写出一帧，按 id 匹配；HTTP 传输（含流水线模式）
+     * 从连接池取一个连接发送批量请求，收到响应后按 id 分发。
+     */
+    void send_batch(std::vector<Request>& requests,
+                    std::vector<detail::CallBatcher::Callback>& callbacks)
+    {
+        if (requests.size() == 1) {
+            send_call(requests.front(), std::move(callbacks.front()));
+            return;
+        }
+
+        // 整批计为一个在途请求：第一个完成的回调即代表整批的结果
+        std::size_t index = balancer_.acquire();
+        if (!backends_[index]->limiter.enabled()) {
+            dispatch_batch(index, requests, callbacks, false);
+            return;
+        }
+
+        auto shared_requests = std::make_shared<std::vector<Request>>(std::move(requests));
+        auto shared_callbacks = std::make_shared<std::vector<detail::CallBatcher::Callback>>(std::move(callbacks));
+        admit(index,
+            [this, index, shared_requests, shared_callbacks](bool limited) {
+                dispatch_batch(index, *shared_requests, *shared_callbacks, limited);
+            },
+            [this, shared_requests, shared_callbacks]() {
+                for (std::size_t i = 0; i < shared_requests->size(); ++i) {
+                    boost::asio::post(io_context_, std::bind((*shared_callbacks)[i], overloaded((*shared_requests)[i].id())));
+                }
+            });
+    }
+
+    /**
+     * @brief 在选中的端点上发出合批请求
+     */
+    void dispatch_batch(std::size_t index,
+                        std::vector<Request>& requests,
+                        std::vector<detail::CallBatcher::Callback>& callbacks,
+                        bool limited)
+    {
+        Backend& backend = *backends_[index];
+        auto batch_done = std::make_shared<std::function<void(const Response&)>>(
+            track(index, [](const Response&) {}, limited));
+        for (auto& callback : callbacks) {
+            detail::CallBatcher::Callback inner = std::move(callback);
+            callback = [batch_done, inner](const Response& response) {
+                if (*batch_done) {
+                    (*batch_done)(response);
+                    *batch_done = nullptr;
+                }
+                inner(response);
+            };
+        }
+
+        if (transport_ != Transport::Http) {
+            framed_session(backend)->async_call_batch(requests, timeout_, std::move(callbacks));
+            return;
+        }
+
+        auto ids = std::make_shared<std::vector<std::int64_t>>();
+        ids->reserve(requests.size());
+        for (const auto& request : requests) {
+            ids->push_back(request.id().as_int64());
+        }
+        auto shared_callbacks = std::make_shared<std::vector<detail::CallBatcher::Callback>>(std::move(callbacks));
+
+        auto session = acquire_session(backend);
+        Backend* owner = &backend;
+        session->async_call_batch(requests,
+            [owner, session, ids, shared_callbacks](const std::vector<Response>& responses) {
+                owner->pool.release(session);
+                detail::fan_out_responses(*ids, *shared_callbacks, responses);
+            });
     }
 
     /**
      * @brief 发送通知
+     *
+     * 启用通知队列时只序列化并入队，由后台线程发送；否则同步发送。
      */
     void notify(const Request& request) {
-        auto session = create_session();
+        Backend& backend = *backends_[pick_for_notify()];
+        auto sender = notifier(backend);
+        if (sender) {
+            sender->push(detail::Protocol::serialize_request(request));
+            return;
+        }
+        if (transport_ != Transport::Http) {
+            create_framed_session(backend)->notify(request);
+            return;
+        }
+        auto session = acquire_session(backend);
         session->notify(request);
+        backend.pool.release(std::move(session));
+    }
+
+    /**
+     * @brief 设置自适应并发上限（各端点独立计数，上限复位为初始值）
+     */
+    void set_concurrency_limit(const ConcurrencyLimitPolicy& policy) {
+        {
+            std::lock_guard<std::mutex> lock(policy_mutex_);
+            limit_policy_ = policy;
+        }
+        apply_concurrency_limit();
+    }
+
+    /**
+     * @brief 设置重试策略
+     */
+    void set_retry_policy(const RetryPolicy& policy) {
+        std::lock_guard<std::mutex> lock(policy_mutex_);
+        retry_ = policy;
+    }
+
+    /**
+     * @brief 设置对冲策略
+     */
+    void set_hedging(const HedgePolicy& policy) {
+        std::lock_guard<std::mutex> lock(policy_mutex_);
+        hedge_ = policy;
+    }
+
+    /**
+     * @brief 标记方法是否幂等
+     */
+    void set_idempotent(const std::string& method, bool idempotent) {
+        std::lock_guard<std::mutex> lock(policy_mutex_);
+        if (idempotent) {
+            idempotent_.insert(method);
+        } else {
+            idempotent_.erase(method);
+        }
     }
 
     void set_logger(std::function<void(const std::string&)> logger) {
-        logger_ = std::move(logger);
+        {
+            std::lock_guard<std::mutex> lock(framed_mutex_);
+            logger_ = std::move(logger);
+            reset_framed_sessions();
+            for (auto& backend : backends_) {
+                backend->pool.clear();
+            }
+        }
+        reset_notifiers();
     }
 
 private:
+    /**
+     * @brief 方法是否幂等且启用了重试或对冲；是则取出当前策略
+     */
+    bool resilient(const std::string& method, RetryPolicy& retry, HedgePolicy& hedge) {
+        std::lock_guard<std::mutex> lock(policy_mutex_);
+        if (idempotent_.empty() || idempotent_.count(method) == 0) {
+            return false;
+        }
+        retry = retry_;
+        hedge = hedge_;
+        return retry.max_attempts > 1 || hedge.max_hedges > 0;
+    }
+
+    /**
+     * @brief 发起带重试与对冲的异步调用（不经过自动合批）
+     */
+    void start_hedged(const Request& request, const RetryPolicy& retry, const HedgePolicy& hedge,
+                      std::function<void(const Response&)> callback)
+    {
+        detail::HedgedCall::start(io_context_, request, retry, hedge, latencies_,
+            [this](const Request& copy, bool hedged, std::function<void(const Response&)> done) {
+                send_call(copy, std::move(done), hedged);
+            },
+            [this]() {
+                return generate_id();
+            },
+            std::move(callback));
+    }
+
+    /**
+     * @brief 同步等待带重试与对冲的调用
+     *
+     * 副本需要并发在途，因此走异步路径。未启用内部 I/O 线程时在调用线程中运行事件循环直到完成，
+     * 期间也会执行其他异步调用的回调。
+     */
+    Response call_hedged(const Request& request, const RetryPolicy& retry, const HedgePolicy& hedge) {
+        auto result = std::make_shared<std::promise<Response>>();
+        std::future<Response> future = result->get_future();
+        start_hedged(request, retry, hedge, [result](const Response& response) {
+            result->set_value(response);
+        });
+
+        if (io_thread_count_.load() == 0) {
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                restart_if_stopped();
+                io_context_.run_one_for(std::chrono::milliseconds(10));
+            }
+        }
+        return future.get();
+    }
+
+    /**
+     * @brief 在选中的端点上执行同步调用，并向负载均衡器报告结果与耗时
+     *
+     * 只有网络错误计为端点失败，服务端返回的 RPC 错误不影响端点状态。
+     */
+    template<typename Function>
+    auto tracked_call(Function function) -> decltype(function(std::declval<Backend&>())) {
+        std::size_t index = balancer_.acquire();
+        detail::ConcurrencyLimiter& limiter = backends_[index]->limiter;
+        bool limited = limiter.enabled();
+        if (limited && !wait_for_slot(limiter)) {
+            balancer_.cancel(index);
+            throw overloaded(boost::json::value()).error();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            auto result = function(*backends_[index]);
+            complete(index, limited, false, std::chrono::steady_clock::now() - start);
+            return result;
+        } catch (const Error& e) {
+            complete(index, limited, detail::is_transport_error(e), std::chrono::steady_clock::now() - start);
+            throw;
+        } catch (...) {
+            complete(index, limited, false, std::chrono::steady_clock::now() - start);
+            throw;
+        }
+    }
+
+    /**
+     * @brief 向负载均衡器与并发限制器报告一次完成
+     */
+    void complete(std::size_t index, bool limited, bool network_error, std::chrono::steady_clock::duration elapsed) {
+        balancer_.release(index, !network_error, elapsed);
+        if (limited) {
+            backends_[index]->limiter.release(network_error, elapsed);
+        }
+    }
+
+    /**
+     * @brief 异步调用经并发限制器放行后执行 start(true)；被拒绝时撤销端点选择并执行 reject()
+     */
+    void admit(std::size_t index, std::function<void(bool)> start, std::function<void()> reject) {
+        detail::LoadBalancer* balancer = &balancer_;
+        backends_[index]->limiter.acquire([index, balancer, start, reject](bool granted) {
+            if (granted) {
+                start(true);
+                return;
+            }
+            balancer->cancel(index);
+            reject();
+        });
+    }
+
+    /**
+     * @brief 同步调用等待并发名额（最多等待一个超时时间）
+     *
+     * 未启用内部 I/O 线程时，名额要靠本线程运行事件循环完成的异步调用归还，
+     * 因此与 call_hedged 相同，在等待期间驱动事件循环。
+     */
+    bool wait_for_slot(detail::ConcurrencyLimiter& limiter) {
+        struct SlotWait {
+            SlotWait() : state(0), abandoned(false) {}
+            std::mutex mutex;
+            std::condition_variable ready;
+            int state;          // 0 等待，1 放行，2 拒绝
+            bool abandoned;     // 调用方已放弃等待
+        };
+
+        auto wait = std::make_shared<SlotWait>();
+        detail::ConcurrencyLimiter* owner = &limiter;
+        limiter.acquire([wait, owner](bool granted) {
+            std::lock_guard<std::mutex> lock(wait->mutex);
+            if (wait->abandoned) {
+                // 调用方已超时返回，归还迟到的名额
+                if (granted) {
+                    owner->cancel();
+                }
+                return;
+            }
+            wait->state = granted ? 1 : 2;
+            wait->ready.notify_one();
+        });
+
+        auto deadline = std::chrono::steady_clock::now() + timeout_;
+        std::unique_lock<std::mutex> lock(wait->mutex);
+        if (io_thread_count_.load() == 0) {
+            while (wait->state == 0) {
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    break;
+                }
+                lock.unlock();
+                restart_if_stopped();
+                io_context_.run_one_for(std::min<std::chrono::steady_clock::duration>(
+                    deadline - now, std::chrono::milliseconds(10)));
+                lock.lock();
+            }
+        } else {
+            wait->ready.wait_until(lock, deadline, [&wait]() { return wait->state != 0; });
+        }
+
+        if (wait->state == 0) {
+            wait->abandoned = true;
+            return false;
+        }
+        return wait->state == 1;
+    }
+
+    /**
+     * @brief 因并发上限被拒绝的响应
+     */
+    static Response overloaded(const boost::json::value& id) {
+        return Response(Error(ErrorCode::Overloaded, "并发调用数已达上限，调用未发出"), id);
+    }
+
+    /**
+     * @brief 把当前并发上限策略应用到各端点
+     */
+    void apply_concurrency_limit() {
+        ConcurrencyLimitPolicy policy;
+        {
+            std::lock_guard<std::mutex> lock(policy_mutex_);
+            policy = limit_policy_;
+        }
+        for (auto& backend : backends_) {
+            backend->limiter.configure(policy, timeout_);
+        }
+    }
+
+    /**
+     * @brief 包装异步回调：完成时向负载均衡器报告结果与耗时
+     */
+    std::function<void(const Response&)> track(std::size_t index, std::function<void(const Response&)> callback,
+                                               bool limited) {
+        auto start = std::chrono::steady_clock::now();
+        detail::LoadBalancer* balancer = &balancer_;
+        detail::ConcurrencyLimiter* limiter = limited ? &backends_[index]->limiter : nullptr;
+        return [balancer, limiter, index, start, callback](const Response& response) {
+            bool network_error = response.is_error() && detail::is_transport_error(response.error());
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            balancer->release(index, !network_error, elapsed);
+            // 先归还名额，回调中发起的调用与排队中的调用可以立即发出
+            if (limiter) {
+                limiter->release(network_error, elapsed);
+            }
+            callback(response);
+        };
+    }
+
+    /**
+     * @brief 通知不计入在途请求，只借用选择策略
+     *
+     * 通知没有响应，不能当作一次成功的调用：用 cancel() 归还，不影响延迟与连续失败统计。
+     */
+    std::size_t pick_for_notify() {
+        if (backends_.size() == 1) {
+            return 0;
+        }
+        std::size_t index = balancer_.acquire();
+        balancer_.cancel(index);
+        return index;
+    }
+
+    /**
+     * @brief 丢弃各端点的多路复用会话（调用方持有 framed_mutex_）
+     */
+    void reset_framed_sessions() {
+        for (auto& backend : backends_) {
+            backend->framed.reset();
+        }
+    }
+
+    std::vector<std::shared_ptr<detail::NotificationSender>> current_notifiers() {
+        std::vector<std::shared_ptr<detail::NotificationSender>> senders;
+        std::lock_guard<std::mutex> lock(framed_mutex_);
+        for (auto& backend : backends_) {
+            if (backend->notifier) {
+                senders.push_back(backend->notifier);
+            }
+        }
+        return senders;
+    }
+
+    void stop_io_threads_locked() {
+        if (io_threads_.empty()) {
+            return;
+        }
+        // 撤销工作计数后，线程在所有在途操作完成后退出
+        io_work_.reset();
+        for (auto& thread : io_threads_) {
+            thread.join();
+        }
+        io_threads_.clear();
+        io_thread_count_ = 0;
+    }
+
     boost::asio::io_context io_context_;                ///< I/O 上下文
-    std::string host_;                                  ///< 服务器地址
-    std::string port_;                                  ///< 服务器端口
     std::chrono::milliseconds timeout_;                 ///< 超时时间
     std::atomic<int64_t> next_id_;                      ///< 下一个请求 ID
     std::function<void(const std::string&)> logger_;    ///< 日志回调
+    std::shared_ptr<detail::EndpointCache> endpoint_cache_;  ///< 各会话共用的 DNS 解析缓存
+    Transport transport_;                               ///< 传输方式
+    bool pipelining_;                                   ///< HTTP 异步调用是否使用流水线
+    std::size_t batch_size_;                            ///< 自动合批的单批上限（不大于 1 表示关闭）
+    std::chrono::milliseconds batch_delay_;             ///< 自动合批的最长等待时间
+    std::shared_ptr<detail::CallBatcher> batcher_;      ///< 合批器（启用时创建）
+    std::size_t notify_capacity_;                       ///< 通知队列容量（0 表示同步发送）
+    NotifyOverflow notify_policy_;                      ///< 通知队列满时的处理方式
+    std::atomic<std::size_t> dropped_before_;           ///< 已替换的发送器丢弃的通知数
+    std::mutex framed_mutex_;                           ///< 保护多路复用会话与通知发送器的创建
+    typedef boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_type;
+    std::unique_ptr<work_guard_type> io_work_;          ///< 内部 I/O 线程运行期间保持 io_context_ 不退出
+    std::vector<std::thread> io_threads_;               ///< 内部 I/O 线程
+    std::atomic<std::size_t> io_thread_count_;          ///< 内部 I/O 线程数（0 表示由调用方运行事件循环）
+    std::mutex io_mutex_;                               ///< 保护 I/O 线程的启动与停止
+    std::mutex policy_mutex_;                           ///< 保护以下重试与对冲配置
+    RetryPolicy retry_;                                 ///< 重试策略
+    HedgePolicy hedge_;                                 ///< 对冲策略
+    std::unordered_set<std::string> idempotent_;        ///< 幂等方法（只有这些方法重试与对冲）
+    std::shared_ptr<detail::LatencyWindow> latencies_;  ///< 最近成功调用的延迟，用于对冲延迟
+    ConcurrencyLimitPolicy limit_policy_;               ///< 自适应并发上限策略（policy_mutex_ 保护）
+    detail::LoadBalancer balancer_;                     ///< 端点选择与统计
+    std::vector<std::unique_ptr<Backend>> backends_;    ///< 各端点的连接资源（构造后不变，在 io_context_ 之前析构）
 };
 
 // ============================================================================
@@ -116,7 +953,12 @@ private:
 // ============================================================================
 
 inline Client::Client(const std::string& host, unsigned short port)
-    : impl_(new Impl(host, port))
+    : impl_(new Impl(std::vector<Endpoint>{Endpoint{host, port}}))
+{
+}
+
+inline Client::Client(const std::vector<Endpoint>& endpoints)
+    : impl_(new Impl(endpoints))
 {
 }
 
@@ -139,15 +981,132 @@ inline void Client::set_logger(std::function<void(const std::string&)> logger) {
     impl_->set_logger(std::move(logger));
 }
 
+// ============================================================================
+// 设置传输方式
+// ============================================================================
+
+inline void Client::set_transport(Transport transport) {
+    impl_->set_transport(transport);
+}
+
+inline Transport Client::transport() const {
+    return impl_->transport();
+}
+
+inline void Client::set_auto_batching(std::size_t max_batch, std::chrono::milliseconds max_delay) {
+    impl_->set_auto_batching(max_batch, max_delay);
+}
+
+inline void Client::set_pipelining(bool enable) {
+    impl_->set_pipelining(enable);
+}
+
+inline bool Client::pipelining() const {
+    return impl_->pipelining();
+}
+
+// ============================================================================
+// 内部 I/O 线程
+// ============================================================================
+
+inline void Client::set_io_threads(std::size_t count) {
+    impl_->set_io_threads(count);
+}
+
+inline std::size_t Client::io_threads() const {
+    return impl_->io_threads();
+}
+
+// ============================================================================
+// DNS 解析缓存
+// ============================================================================
+
+inline void Client::set_dns_cache_ttl(std::chrono::milliseconds ttl) {
+    impl_->endpoint_cache().set_ttl(ttl);
+}
+
+// ============================================================================
+// 多端点负载均衡
+// ============================================================================
+
+inline void Client::set_load_balancing(LoadBalancePolicy policy) {
+    impl_->balancer().set_policy(policy);
+}
+
+inline void Client::set_outlier_ejection(std::size_t consecutive_failures, std::chrono::milliseconds duration) {
+    impl_->balancer().set_ejection(consecutive_failures, duration);
+}
+
+inline std::vector<EndpointStatus> Client::endpoint_status() const {
+    return impl_->endpoint_status();
+}
+
+// ============================================================================
+// 自适应并发上限
+// ============================================================================
+
+inline void Client::set_concurrency_limit(const ConcurrencyLimitPolicy& policy) {
+    impl_->set_concurrency_limit(policy);
+}
+
+// ============================================================================
+// 重试与对冲
+// ============================================================================
+
+inline void Client::set_retry_policy(const RetryPolicy& policy) {
+    impl_->set_retry_policy(policy);
+}
+
+inline void Client::set_hedging(const HedgePolicy& policy) {
+    impl_->set_hedging(policy);
+}
+
+inline void Client::set_idempotent(const std::string& method, bool idempotent) {
+    impl_->set_idempotent(method, idempotent);
+}
+
+// ============================================================================
+// 通知队列
+// ============================================================================
+
+inline void Client::set_notify_queue(std::size_t capacity, NotifyOverflow policy) {
+    impl_->set_notify_queue(capacity, policy);
+}
+
+inline void Client::flush_notifications() {
+    impl_->flush_notifications();
+}
+
+inline std::size_t Client::dropped_notifications() const {
+    return impl_->dropped_notifications();
+}
+
+// ============================================================================
+// HTTP 连接池
+// ============================================================================
+
+inline void Client::set_max_idle_connections(std::size_t count) {
+    impl_->set_max_idle_connections(count);
+}
+
+inline void Client::set_idle_timeout(std::chrono::milliseconds timeout) {
+    impl_->set_idle_timeout(timeout);
+}
+
+inline void Client::preconnect(std::size_t count) {
+    impl_->preconnect(count);
+}
+
+inline std::size_t Client::idle_connections() const {
+    return impl_->idle_connections();
+}
+
 // ============================================================================
 // 同步调用（模板函数实现）
 // ============================================================================
 
 template<typename Result, typename... Args>
 Result Client::call(const std::string& method, Args&&... args) {
-    // 生成请求 ID
-    boost::json::value id = impl_->generate_id();
-
     // 转换参数为 JSON
     boost::json::array params;
     int dummy[] = {0, (
@@ -156,11 +1115,8 @@ Result Client::call(const std::string& method, Args&&... args) {
         )), 0)...};
     (void)dummy;  // 避免未使用警告
 
-    // 构造请求
-    Request request(method, params, id);
-
     // 同步调用
-    Response response = impl_->call(request);
+    Response response = call_params(method, std::move(params));
 
     // 检查错误
     if (response.is_error()) {
@@ -179,6 +1135,51 @@ template<typename... Args>
 void Client::async_call(const std::string& method,
                        std::function<void(const Response&)> callback,
                        Args&&... args)
+{
+    // 转换参数为 JSON
+    boost::json::array params;
+    int dummy[] = {0, (
+        params.push_back(detail::json_converter<typename std::decay<Args>::type>::to_json(
+            std::forward<Args>(args)
+        )), 0)...};
+    (void)dummy;
+
+    // 异步调用
+    async_call_params(method, std::move(params), std::move(callback));
+}
+
+// ============================================================================
+// 异步调用（完成令牌）
+// ============================================================================
+
+/**
+ * @brief async_initiate 的发起对象：把令牌生成的处理器包装为内部回调后发起调用
+ */
+template<typename Result>
+class Client::CallInitiation {
+public:
+    explicit CallInitiation(Impl* impl)
+        : impl_(impl)
+    {}
+
+    template<typename Handler>
+    void operator()(Handler&& handler, const Request& request) const {
+        typedef detail::TypedCompletion<Result, typename std::decay<Handler>::type> completion_type;
+        impl_->async_call(request, completion_type::wrap(std::forward<Handler>(handler),
+                                                         impl_->get_io_context().get_executor()));
+    }
+
+private:
+    Impl* impl_;
+};
+
+template<typename Result, typename CompletionToken, typename... Args>
+auto Client::async_call(const std::string& method, CompletionToken&& token, Args&&... args)
+    -> typename std::enable_if<
+           !detail::is_response_callback<CompletionToken>::value,
+           typename boost::asio::async_result<
+               typename std::decay<CompletionToken>::type,
+               typename detail::call_completion<Result>::signature>::return_type>::type
 {
     // 生成请求 ID
     boost::json::value id = impl_->generate_id();
@@ -191,11 +1192,10 @@ void Client::async_call(const std::string& method,
         )), 0)...};
     (void)dummy;
 
-    // 构造请求
     Request request(method, params, id);
 
-    // 异步调用
-    impl_->async_call(request, callback);
+    return boost::asio::async_initiate<CompletionToken, typename detail::call_completion<Result>::signature>(
+        CallInitiation<Result>(impl_.get()), token, request);
 }
 
 // ============================================================================
@@ -206,6 +1206,25 @@ inline std::vector<Response> Client::call_batch(const std::vector<Request>& requ
     return impl_->call_batch(requests);
 }
 
+// ============================================================================
+// 以参数数组调用
+// ============================================================================
+
+inline Response Client::call_params(const std::string& method, boost::json::array params) {
+    Request request(method, std::move(params), impl_->generate_id());
+    return impl_->call(request);
+}
+
+inline void Client::async_call_params(const std::string& method, boost::json::array params,
+                                      std::function<void(const Response&)> callback) {
+    Request request(method, std::move(params), impl_->generate_id());
+    impl_->async_call(request, std::move(callback));
+}
+
+inline void Client::notify_params(const std::string& method, boost::json::array params) {
+    impl_->notify(Request(method, std::move(params)));
+}
+
 // ============================================================================
 // 发送通知（模板函数实现）
 // ============================================================================
@@ -220,11 +1239,8 @@ void Client::notify(const std::string& method, Args&&... args) {
         )), 0)...};
     (void)dummy;
 
-    // 构造请求（无 ID）
-    Request request(method, params);
-
     // 发送通知
-    impl_->notify(request);
+    notify_params(method, std::move(params));
 }
 
 // ============================================================================
@@ -232,6 +1248,8 @@ void Client::notify(const std::string& method, Args&&... args) {
 // ============================================================================
 
 inline void Client::run() {
+    impl_->ensure_caller_driven();
+    impl_->restart_if_stopped();
     impl_->get_io_context().run();
 }
 
@@ -240,6 +1258,8 @@ inline void Client::run() {
 // ============================================================================
 
 inline std::size_t Client::poll() {
+    impl_->ensure_caller_driven();
+    impl_->restart_if_stopped();
     return impl_->get_io_context().poll();
 }
 
@@ -248,6 +1268,8 @@ inline std::size_t Client::poll() {
 // ============================================================================
 
 inline std::size_t Client::run_for(std::chrono::steady_clock::duration duration) {
+    impl_->ensure_caller_driven();
+    impl_->restart_if_stopped();
     return impl_->get_io_context().run_for(duration);
 }
 
@@ -256,6 +1278,8 @@ inline std::size_t Client::run_for(std::chrono::steady_clock::duration duration)
 // ============================================================================
 
 inline std::size_t Client::run_until_idle() {
+    impl_->ensure_caller_driven();
+    impl_->restart_if_stopped();
     std::size_t total = 0;
     while (true) {
         std::size_t processed = impl_->get_io_context().poll();
@@ -2,6 +2,7 @@
 
 #include <jsonrpc/detail/client_session.hpp>
 #include <jsonrpc/detail/protocol.hpp>
+#include <jsonrpc/detail/transport_error.hpp>
 #include <jsonrpc/errors.hpp>
 
 namespace jsonrpc {
@@ -16,14 +17,18 @@ inline ClientSession::ClientSession(
     const std::string& host,
     const std::string& port,
     std::chrono::milliseconds timeout,
-    std::function<void(const std::string&)> logger)
+    std::function<void(const std::string&)> logger,
+    std::shared_ptr<EndpointCache> endpoint_cache)
     : io_context_(io_context)
-    , resolver_(io_context)
-    , stream_(io_context)
+    , strand_(boost::asio::make_strand(io_context))
+    , resolver_(strand_)
+    , stream_(strand_)
     , host_(host)
     , port_(port)
     , timeout_(timeout)
     , logger_(std::move(logger))
+    , endpoint_cache_(std::move(endpoint_cache))
+    , connected_(false)
 {
 }
 
@@ -33,6 +38,83 @@ inline void ClientSession::log(const std::string& message) const {
     }
 }
 
+inline std::string ClientSession::host_header() const {
+    return http_host_header(host_);
+}
+
+// ============================================================================
+// 连接管理
+// ============================================================================
+
+inline void ClientSession::connect() {
+    if (connected_) {
+        return;
+    }
+
+    try {
+        // 解析域名（优先使用缓存；Unix 域套接字直接使用路径）
+        auto const endpoints = resolve_endpoints(resolver_, host_, port_, endpoint_cache_);
+
+        // 设置超时
+        stream_.expires_after(timeout_);
+
+        // 连接到服务器
+        stream_.connect(endpoints);
+        connected_ = true;
+
+    } catch (const boost::system::system_error& e) {
+        // 缓存的地址可能已失效，下次重新解析
+        if (endpoint_cache_) {
+            endpoint_cache_->invalidate(host_, port_);
+        }
+        log(std::string("网络错误: ") + e.what());
+        throw transport_error(e.what());
+    }
+}
+
+inline void ClientSession::close() {
+    if (!connected_) {
+        return;
+    }
+    connected_ = false;
+
+    // 优雅关闭连接
+    boost::beast::error_code ec;
+    stream_.socket().shutdown(boost::asio::socket_base::shutdown_both, ec);
+    stream_.socket().close(ec);
+}
+
+inline bool ClientSession::reusable() {
+    // 空闲连接上不应有任何数据；对端已关闭时 peek 会立即返回 0 字节或错误
+    return connected_ && probe_socket(stream_.socket()) == SocketProbe::Idle;
+}
+
+inline void ClientSession::prepare_request(const std::string& request_body, bool with_timeout) {
+    req_ = {};
+    req_.version(11);  // HTTP/1.1，默认保持连接
+    req_.method(boost::beast::http::verb::post);
+    req_.target("/");
+    req_.set(boost::beast::http::field::host, host_header());
+    req_.set(boost::beast::http::field::content_type, "application/json");
+    req_.set(boost::beast::http::field::user_agent, "jsonrpc-client");
+    if (with_timeout) {
+        // 服务端据此丢弃排队超时、本端已不再等待的请求
+        req_.set(timeout_header, std::to_string(timeout_.count()));
+    }
+    req_.body() = request_body;
+    req_.prepare_payload();
+}
+
+inline std::string ClientSession::take_response_body() {
+    std::string response_body = std::move(res_.body());
+
+    // 服务端要求关闭时不再复用
+    if (!res_.keep_alive()) {
+        close();
+    }
+    return response_body;
+}
+
 // ============================================================================
 // 同步调用
 // ============================================================================
@@ -88,8 +170,7 @@ inline void ClientSession::async_call(const Request& request,
     send_request_async(request_body, [self, callback](boost::beast::error_code ec, const std::string& response_body) {
         if (ec) {
             // 网络错误，转换为 RPC 错误响应
-            Error error(ErrorCode::InternalError,
-                       std::string("网络错误: ") + ec.message());
+            Error error = transport_error(ec.message());
             Response error_response(error, boost::json::value(nullptr));
             callback(error_response);
             return;
@@ -108,6 +189,50 @@ inline void ClientSession::async_call(const Request& request,
     });
 }
 
+// ============================================================================
+// 异步批量调用
+// ============================================================================
+
+inline void ClientSession::async_call_batch(const std::vector<Request>& requests,
+                                            std::function<void(const std::vector<Response>&)> callback)
+{
+    std::string request_body = Protocol::serialize_batch_request(requests);
+
+    // 出错时每个请求都需要一个带自身 id 的错误响应
+    auto ids = std::make_shared<std::vector<boost::json::value>>();
+    ids->reserve(requests.size());
+    for (const auto& request : requests) {
+        ids->push_back(request.id());
+    }
+
+    auto self = shared_from_this();
+    send_request_async(request_body, [self, ids, callback](boost::beast::error_code ec, const std::string& response_body) {
+        auto fail = [&ids, &callback](const Error& error) {
+            std::vector<Response> responses;
+            responses.reserve(ids->size());
+            for (const auto& id : *ids) {
+                responses.push_back(Response(error, id));
+            }
+            callback(responses);
+        };
+
+        if (ec) {
+            fail(transport_error(ec.message()));
+            return;
+        }
+
+        std::vector<Response> responses;
+        try {
+            responses = Protocol::parse_batch_response(response_body);
+        } catch (const Error& e) {
+            self->log(std::string("解析批量响应失败: ") + e.what());
+            fail(e);
+            return;
+        }
+        callback(responses);
+    });
+}
+
 // ============================================================================
 // 发送通知
 // ============================================================================
@@ -118,7 +243,7 @@ inline void ClientSession::notify(const Request& request) {
 
     // 发送请求（不等待响应）
     try {
-        send_request_sync(request_body);
+        send_request_sync(request_body, false);
     } catch (...) {
         // 通知类型的请求，忽略错误
     }
@@ -128,52 +253,29 @@ inline void ClientSession::notify(const Request& request) {
 // 同步发送请求并接收响应
 // ============================================================================
 
-inline std::string ClientSession::send_request_sync(const std::string& request_body) {
-    try {
-        // 解析域名
-        auto const results = resolver_.resolve(host_, port_);
-
-        // 设置超时
-        stream_.expires_after(timeout_);
+inline std::string ClientSession::send_request_sync(const std::string& request_body, bool with_timeout) {
+    connect();
 
-        // 连接到服务器
-        stream_.connect(results);
-
-        // 构造 HTTP 请求
-        req_ = {};
-        req_.version(11);  // HTTP/1.1
-        req_.method(boost::beast::http::verb::post);
-        req_.target("/");
-        req_.set(boost::beast::http::field::host, host_);
-        req_.set(boost::beast::http::field::content_type, "application/json");
-        req_.set(boost::beast::http::field::user_agent, "jsonrpc-client");
-        req_.body() = request_body;
-        req_.prepare_payload();
+    try {
+        prepare_request(request_body, with_timeout);
 
         // 发送 HTTP 请求
         stream_.expires_after(timeout_);
         boost::beast::http::write(stream_, req_);
 
         // 接收 HTTP 响应
-        buffer_ = {};
+        buffer_.clear();
         res_ = {};
         stream_.expires_after(timeout_);
         boost::beast::http::read(stream_, buffer_, res_);
 
-        // 提取响应 body
-        std::string response_body = res_.body();
-
-        // 优雅关闭连接
-        boost::beast::error_code ec;
-        stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
-
-        return response_body;
+        return take_response_body();
 
     } catch (const boost::system::system_error& e) {
-        // 网络错误
+        // 网络错误，连接状态未知，不再复用
+        close();
         log(std::string("网络错误: ") + e.what());
-        throw Error(ErrorCode::InternalError,
-                   std::string("网络错误: ") + e.what());
+        throw transport_error(e.what());
     }
 }
 
@@ -184,32 +286,15 @@ inline std::string ClientSession::send_request_sync(const std::string& request_b
 inline void ClientSession::send_request_async(const std::string& request_body,
                                               std::function<void(boost::beast::error_code, const std::string&)> callback)
 {
-    // 构造 HTTP 请求
-    req_ = {};
-    req_.version(11);
-    req_.method(boost::beast::http::verb::post);
-    req_.target("/");
-    req_.set(boost::beast::http::field::host, host_);
-    req_.set(boost::beast::http::field::content_type, "application/json");
-    req_.set(boost::beast::http::field::user_agent, "jsonrpc-client");
-    req_.body() = request_body;
-    req_.prepare_payload();
+    prepare_request(request_body, true);
 
-    // 异步连接
     auto self = shared_from_this();
-    do_connect([self, callback](boost::beast::error_code ec) {
-        if (ec) {
-            // 连接错误，直接传递错误码
-            self->log(std::string("连接失败: ") + ec.message());
-            callback(ec, "");
-            return;
-        }
-
+    auto exchange = [self, callback]() {
         // 异步写入
         self->do_write([self, callback](boost::beast::error_code ec) {
             if (ec) {
                 // 写入错误，直接传递错误码
-                self->log(std::string("写入请求失败: ") + ec.message());
+                self->close();
                 callback(ec, "");
                 return;
             }
@@ -218,25 +303,32 @@ inline void ClientSession::send_request_async(const std::string& request_body,
             self->do_read([self, callback](boost::beast::error_code ec) {
                 if (ec) {
                     // 读取错误，直接传递错误码
-                    self->log(std::string("读取响应失败: ") + ec.message());
+                    self->close();
                     callback(ec, "");
                     return;
                 }
 
-                // 提取响应 body
-                std::string response_body = self->res_.body();
-
-                // 关闭连接
-                boost::beast::error_code close_ec;
-                self->stream_.socket().shutdown(
-                    boost::asio::ip::tcp::socket::shutdown_both,
-                    close_ec
-                );
-
                 // 成功，传递空错误码和响应字符串
-                callback(boost::beast::error_code(), response_body);
+                callback(boost::beast::error_code(), self->take_response_body());
             });
         });
+    };
+
+    // 已连接时直接复用
+    if (connected_) {
+        exchange();
+        return;
+    }
+
+    // 异步连接
+    do_connect([self, callback, exchange](boost::beast::error_code ec) {
+        if (ec) {
+            // 连接错误，直接传递错误码
+            callback(ec, "");
+            return;
+        }
+        self->connected_ = true;
+        exchange();
     });
 }
 
@@ -247,9 +339,8 @@ inline void ClientSession::send_request_async(const std::string& request_body,
 inline void ClientSession::do_connect(std::function<void(boost::beast::error_code)> callback) {
     // 异步解析域名
     auto self = shared_from_this();
-    resolver_.async_resolve(host_, port_,
-        [self, callback](boost::beast::error_code ec,
-                        boost::asio::ip::tcp::resolver::results_type results) {
+    async_resolve_endpoints(resolver_, host_, port_, endpoint_cache_,
+        [self, callback](boost::beast::error_code ec, endpoint_list endpoints) {
             if (ec) {
                 self->log(std::string("解析域名失败: ") + ec.message());
                 callback(ec);
@@ -260,10 +351,13 @@ inline void ClientSession::do_connect(std::function<void(boost::beast::error_cod
             self->stream_.expires_after(self->timeout_);
 
             // 异步连接
-            self->stream_.async_connect(results,
+            self->stream_.async_connect(endpoints,
                 [self, callback](boost::beast::error_code ec,
-                          boost::asio::ip::tcp::resolver::results_type::endpoint_type) {
+                          stream_protocol::endpoint) {
                     if (ec) {
+                        if (self->endpoint_cache_) {
+                            self->endpoint_cache_->invalidate(self->host_, self->port_);
+                        }
                         self->log(std::string("连接失败: ") + ec.message());
                     }
                     callback(ec);
@@ -301,8 +395,8 @@ inline void ClientSession::do_read(std::function<void(boost::beast::error_code)>
     // 设置超时
     stream_.expires_after(timeout_);
 
-    // 清空缓冲区
-    buffer_ = {};
+    // 清空缓冲区（保留已分配的容量）
+    buffer_.clear();
     res_ = {};
 
     // 异步读取
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <jsonrpc/detail/concurrency_limiter.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+inline ConcurrencyLimiter::ConcurrencyLimiter()
+    : enabled_(false)
+    , max_wait_(0)
+    , limit_(0.0)
+    , in_flight_(0)
+    , rtt_long_us_(0.0)
+    , timer_armed_(false)
+{
+    policy_.max_limit = 0;
+}
+
+inline ConcurrencyLimiter::ConcurrencyLimiter(const boost::asio::any_io_executor& executor)
+    : ConcurrencyLimiter()
+{
+    timer_.reset(new boost::asio::steady_timer(executor));
+}
+
+inline void ConcurrencyLimiter::configure(const ConcurrencyLimitPolicy& policy, std::chrono::milliseconds max_wait) {
+    std::deque<std::pair<Starter, bool>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        policy_ = policy;
+        policy_.min_limit = std::max<std::size_t>(policy_.min_limit, 1);
+        max_wait_ = max_wait;
+        limit_ = static_cast<double>(std::min(std::max(policy_.initial_limit, policy_.min_limit),
+                                              std::max(policy_.max_limit, policy_.min_limit)));
+        rtt_long_us_ = 0.0;
+        enabled_ = policy_.max_limit != 0;
+        if (policy_.max_limit == 0) {
+            // 关闭限制：放行所有等待中的调用
+            while (!queue_.empty()) {
+                ready.emplace_back(std::move(queue_.front().start), true);
+                queue_.pop_front();
+            }
+        } else {
+            drain(ready);
+        }
+        // max_wait 可能改变，按新的到期时间重新设置
+        if (timer_armed_) {
+            timer_armed_ = false;
+            timer_->cancel();
+        }
+        schedule_expiry();
+    }
+    run(ready);
+}
+
+inline bool ConcurrencyLimiter::enabled() const {
+    return enabled_.load();
+}
+
+inline std::size_t ConcurrencyLimiter::limit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return policy_.max_limit == 0 ? 0 : static_cast<std::size_t>(limit_);
+}
+
+inline std::size_t ConcurrencyLimiter::queued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+// ============================================================================
+// 申请与归还
+// ============================================================================
+
+inline void ConcurrencyLimiter::acquire(Starter start) {
+    bool granted = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (policy_.max_limit != 0) {
+            if (in_flight_ < static_cast<std::size_t>(limit_)) {
+                ++in_flight_;
+            } else if (queue_.size() < policy_.max_queue) {
+                Waiter waiter;
+                waiter.start = std::move(start);
+                waiter.enqueued = std::chrono::steady_clock::now();
+                queue_.push_back(std::move(waiter));
+                schedule_expiry();
+                return;
+            } else {
+                granted = false;
+            }
+        }
+    }
+    start(granted);
+}
+
+inline void ConcurrencyLimiter::release(bool dropped, std::chrono::steady_clock::duration rtt) {
+    std::deque<std::pair<Starter, bool>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (policy_.max_limit == 0) {
+            return;
+        }
+        if (in_flight_ > 0) {
+            --in_flight_;
+        }
+        double micros = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(rtt).count());
+        update(dropped, std::max(micros, 1.0));
+        drain(ready);
+    }
+    run(ready);
+}
+
+inline void ConcurrencyLimiter::cancel() {
+    std::deque<std::pair<Starter, bool>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (policy_.max_limit == 0) {
+            return;
+        }
+        if (in_flight_ > 0) {
+            --in_flight_;
+        }
+        drain(ready);
+    }
+    run(ready);
+}
+
+inline void ConcurrencyLimiter::drain(std::deque<std::pair<Starter, bool>>& ready) {
+    auto now = std::chrono::steady_clock::now();
+    while (!queue_.empty()) {
+        if (now - queue_.front().enqueued >= max_wait_) {
+            ready.emplace_back(std::move(queue_.front().start), false);
+            queue_.pop_front();
+            continue;
+        }
+        if (in_flight_ >= static_cast<std::size_t>(limit_)) {
+            break;
+        }
+        ++in_flight_;
+        ready.emplace_back(std::move(queue_.front().start), true);
+        queue_.pop_front();
+    }
+    schedule_expiry();
+}
+
+// ============================================================================
+// 排队到期
+// ============================================================================
+
+inline void ConcurrencyLimiter::schedule_expiry() {
+    // 调用方持有 mutex_；所有调用方的 max_wait 相同，队首总是最先到期
+    if (!timer_) {
+        return;
+    }
+    if (queue_.empty()) {
+        if (timer_armed_) {
+            // 没有排队的调用时不保留挂起的定时器，io_context::run() 可以及时返回
+            timer_armed_ = false;
+            timer_->cancel();
+        }
+        return;
+    }
+    if (timer_armed_) {
+        return;
+    }
+
+    timer_armed_ = true;
+    timer_->expires_at(queue_.front().enqueued + max_wait_);
+    timer_->async_wait([this](boost::system::error_code ec) {
+        on_expiry(ec);
+    });
+}
+
+inline void ConcurrencyLimiter::on_expiry(boost::system::error_code ec) {
+    // 被取消时限制器可能已销毁，不再访问成员
+    if (ec == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    std::deque<std::pair<Starter, bool>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer_armed_ = false;
+        drain(ready);
+    }
+    run(ready);
+}
+
+inline void ConcurrencyLimiter::run(std::deque<std::pair<Starter, bool>>& ready) {
+    for (auto& item : ready) {
+        item.first(item.second);
+    }
+}
+
+// ============================================================================
+// 上限调整
+// ============================================================================
+
+inline void ConcurrencyLimiter::update(bool dropped, double rtt_us) {
+    const double min_limit = static_cast<double>(policy_.min_limit);
+    const double max_limit = static_cast<double>(std::max(policy_.max_limit, policy_.min_limit));
+    // 完成时的在途数（含本次）不足上限一半时，说明负载没有用满上限，不据此放大
+    const bool app_limited = static_cast<double>(in_flight_ + 1) * 2.0 < limit_;
+
+    if (dropped) {
+        limit_ = std::max(min_limit, limit_ * policy_.backoff_ratio);
+        return;
+    }
+
+    if (policy_.algorithm == LimitAlgorithm::Aimd) {
+        if (!app_limited) {
+            limit_ = std::min(max_limit, limit_ + 1.0 / limit_);
+        }
+        return;
+    }
+
+    // Gradient：长期平均延迟 / 本次延迟，延迟上升时 < 1 收缩上限；sqrt(limit) 为允许的排队余量
+    if (rtt_long_us_ == 0.0) {
+        rtt_long_us_ = rtt_us;
+    } else {
+        rtt_long_us_ += 0.05 * (rtt_us - rtt_long_us_);
+    }
+    // 延迟长期回落后让平均值较快跟上，避免上限一直偏大
+    if (rtt_long_us_ > rtt_us * 2.0) {
+        rtt_long_us_ *= 0.95;
+    }
+
+    double gradient = std::min(1.0, std::max(0.5, policy_.tolerance * rtt_long_us_ / rtt_us));
+    double target = limit_ * gradient + std::sqrt(limit_);
+    if (app_limited && target > limit_) {
+        return;
+    }
+    limit_ = std::min(max_limit, std::max(min_limit, limit_ * 0.8 + target * 0.2));
+}
+
+} // namespace detail
+} // namespace jsonrpc
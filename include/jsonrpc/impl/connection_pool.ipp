@@ -0,0 +1,103 @@
+#pragma once
+
+#include <jsonrpc/detail/connection_pool.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+inline ConnectionPool::ConnectionPool()
+    : max_idle_(8)
+    , idle_timeout_(std::chrono::seconds(15))  // 短于服务端 30 秒的 keep-alive 超时
+{
+}
+
+inline void ConnectionPool::set_max_idle(std::size_t count) {
+    std::deque<IdleConnection> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_idle_ = count;
+        while (idle_.size() > max_idle_) {
+            dropped.push_back(std::move(idle_.front()));
+            idle_.pop_front();
+        }
+    }
+    for (auto& entry : dropped) {
+        entry.session->close();
+    }
+}
+
+inline std::size_t ConnectionPool::max_idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_idle_;
+}
+
+inline void ConnectionPool::set_idle_timeout(std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_timeout_ = timeout;
+}
+
+inline std::shared_ptr<ClientSession> ConnectionPool::acquire() {
+    while (true) {
+        std::shared_ptr<ClientSession> session;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            evict_expired(std::chrono::steady_clock::now());
+            if (idle_.empty()) {
+                return session;
+            }
+            // 优先使用最近归还的连接，它最可能仍然有效
+            session = std::move(idle_.back().session);
+            idle_.pop_back();
+        }
+
+        if (session->reusable()) {
+            return session;
+        }
+        session->close();
+    }
+}
+
+inline void ConnectionPool::release(std::shared_ptr<ClientSession> session) {
+    if (!session->reusable()) {
+        session->close();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        evict_expired(now);
+        if (idle_.size() < max_idle_) {
+            IdleConnection entry = { std::move(session), now };
+            idle_.push_back(std::move(entry));
+            return;
+        }
+    }
+    session->close();
+}
+
+inline void ConnectionPool::clear() {
+    std::deque<IdleConnection> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dropped.swap(idle_);
+    }
+    for (auto& entry : dropped) {
+        entry.session->close();
+    }
+}
+
+inline std::size_t ConnectionPool::idle_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+inline void ConnectionPool::evict_expired(std::chrono::steady_clock::time_point now) {
+    // 越靠前越旧，遇到未超时的即可停止；被丢弃的连接析构时关闭 socket
+    while (!idle_.empty() && now - idle_.front().since >= idle_timeout_) {
+        idle_.pop_front();
+    }
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <jsonrpc/detail/endpoint_cache.hpp>
+#include <thread>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+inline EndpointCache::EndpointCache(std::chrono::milliseconds ttl)
+    : ttl_(ttl)
+{
+}
+
+inline void EndpointCache::set_ttl(std::chrono::milliseconds ttl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ttl_ = ttl;
+    if (ttl_.count() <= 0) {
+        entries_.clear();
+    }
+}
+
+inline std::chrono::milliseconds EndpointCache::ttl() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ttl_;
+}
+
+inline std::size_t EndpointCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+inline std::string EndpointCache::make_key(const std::string& host, const std::string& port) {
+    return host + ":" + port;
+}
+
+// ============================================================================
+// 查找与写入
+// ============================================================================
+
+inline bool EndpointCache::lookup(const std::string& host, const std::string& port, endpoint_list& out) {
+    bool refresh = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(make_key(host, port));
+        if (it == entries_.end()) {
+            return false;
+        }
+
+        Entry& entry = it->second;
+        out = entry.endpoints;
+        if (!entry.refreshing && std::chrono::steady_clock::now() - entry.resolved_at >= ttl_) {
+            entry.refreshing = true;
+            refresh = true;
+        }
+    }
+
+    if (refresh) {
+        refresh_in_background(host, port);
+    }
+    return true;
+}
+
+inline void EndpointCache::store(const std::string& key, const endpoint_list& endpoints) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ttl_.count() <= 0 || endpoints.empty()) {
+        return;
+    }
+    Entry& entry = entries_[key];
+    entry.endpoints = endpoints;
+    entry.resolved_at = std::chrono::steady_clock::now();
+}
+
+inline void EndpointCache::invalidate(const std::string& host, const std::string& port) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(make_key(host, port));
+    // 正在刷新的条目由刷新结果替换
+    if (it != entries_.end() && !it->second.refreshing) {
+        entries_.erase(it);
+    }
+}
+
+// ============================================================================
+// 后台刷新
+// ============================================================================
+
+inline void EndpointCache::refresh_in_background(const std::string& host, const std::string& port) {
+    // 刷新线程只持有弱引用，Client 析构后结果直接丢弃
+    std::weak_ptr<EndpointCache> weak = shared_from_this();
+    std::thread([weak, host, port]() {
+        boost::asio::io_context io_context;
+        boost::asio::ip::tcp::resolver resolver(io_context);
+
+        endpoint_list endpoints;
+        bool succeeded = false;
+        try {
+            endpoints = resolve_endpoints(resolver, host, port);
+            succeeded = !endpoints.empty();
+        } catch (const boost::system::system_error&) {
+        }
+
+        auto self = weak.lock();
+        if (self) {
+            self->finish_refresh(make_key(host, port), succeeded, endpoints);
+        }
+    }).detach();
+}
+
+inline void EndpointCache::finish_refresh(const std::string& key, bool succeeded, const endpoint_list& endpoints) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return;
+    }
+
+    Entry& entry = it->second;
+    entry.refreshing = false;
+    if (succeeded) {
+        entry.endpoints = endpoints;
+        entry.resolved_at = std::chrono::steady_clock::now();
+    } else {
+        // 保留旧结果，半个 TTL 后再次尝试
+        entry.resolved_at = std::chrono::steady_clock::now() - ttl_ / 2;
+    }
+}
+
+// ============================================================================
+// 解析
+// ============================================================================
+
+inline endpoint_list EndpointCache::resolve(boost::asio::ip::tcp::resolver& resolver,
+                                            const std::string& host,
+                                            const std::string& port)
+{
+    endpoint_list endpoints;
+    if (is_unix_endpoint(host) || !lookup(host, port, endpoints)) {
+        endpoints = resolve_endpoints(resolver, host, port);
+        if (!is_unix_endpoint(host)) {
+            store(make_key(host, port), endpoints);
+        }
+    }
+    return endpoints;
+}
+
+inline void EndpointCache::async_resolve(boost::asio::ip::tcp::resolver& resolver,
+                                         const std::string& host,
+                                         const std::string& port,
+                                         std::function<void(boost::system::error_code, endpoint_list)> handler)
+{
+    endpoint_list endpoints;
+    if (is_unix_endpoint(host)) {
+        async_resolve_endpoints(resolver, host, port, std::move(handler));
+        return;
+    }
+
+    if (lookup(host, port, endpoints)) {
+        boost::asio::post(resolver.get_executor(),
+                          std::bind(handler, boost::system::error_code(), std::move(endpoints)));
+        return;
+    }
+
+    auto self = shared_from_this();
+    std::string key = make_key(host, port);
+    async_resolve_endpoints(resolver, host, port,
+        [self, key, handler](boost::system::error_code ec, endpoint_list endpoints) {
+            if (!ec) {
+                self->store(key, endpoints);
+            }
+            handler(ec, std::move(endpoints));
+        }
+    );
+}
+
+inline endpoint_list resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                                       const std::string& host,
+                                       const std::string& port,
+                                       const std::shared_ptr<EndpointCache>& cache)
+{
+    if (!cache) {
+        return resolve_endpoints(resolver, host, port);
+    }
+    return cache->resolve(resolver, host, port);
+}
+
+inline void async_resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                                    const std::string& host,
+                                    const std::string& port,
+                                    const std::shared_ptr<EndpointCache>& cache,
+                                    std::function<void(boost::system::error_code, endpoint_list)> handler)
+{
+    if (!cache) {
+        async_resolve_endpoints(resolver, host, port, std::move(handler));
+        return;
+    }
+    cache->async_resolve(resolver, host, port, std::move(handler));
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <jsonrpc/detail/frame_codec.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace jsonrpc {
+namespace detail {
+
+namespace frame_codec_detail {
+
+inline void put_uint32(std::string& out, std::size_t pos, std::uint32_t value) {
+    out[pos + 0] = static_cast<char>((value >> 24) & 0xFF);
+    out[pos + 1] = static_cast<char>((value >> 16) & 0xFF);
+    out[pos + 2] = static_cast<char>((value >> 8) & 0xFF);
+    out[pos + 3] = static_cast<char>(value & 0xFF);
+}
+
+inline std::uint32_t get_uint32(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return (static_cast<std::uint32_t>(bytes[0]) << 24) |
+           (static_cast<std::uint32_t>(bytes[1]) << 16) |
+           (static_cast<std::uint32_t>(bytes[2]) << 8) |
+           static_cast<std::uint32_t>(bytes[3]);
+}
+
+} // namespace frame_codec_detail
+
+// ============================================================================
+// 编码
+// ============================================================================
+
+inline std::size_t FrameCodec::begin_frame(Transport transport, std::string& out,
+                                           std::chrono::milliseconds timeout) {
+    std::size_t frame_start = out.size();
+    std::uint32_t millis = 0;
+    if (timeout.count() > 0) {
+        millis = timeout.count() < static_cast<long long>(std::numeric_limits<std::uint32_t>::max())
+            ? static_cast<std::uint32_t>(timeout.count())
+            : std::numeric_limits<std::uint32_t>::max();
+    }
+
+    if (transport == Transport::LengthPrefixed) {
+        // 先占位，end_frame() 时回填；标志位先写入，end_frame() 据此跳过等待时间字段
+        out.append(header_size, '\0');
+        if (millis != 0) {
+            frame_codec_detail::put_uint32(out, frame_start, timeout_flag);
+            out.append(header_size, '\0');
+            frame_codec_detail::put_uint32(out, frame_start + header_size, millis);
+        }
+    } else if (millis != 0) {
+        out.push_back('@');
+        out.append(std::to_string(millis));
+        out.push_back(' ');
+    }
+    return frame_start;
+}
+
+inline void FrameCodec::end_frame(Transport transport, std::string& out, std::size_t frame_start) {
+    if (transport == Transport::LengthPrefixed) {
+        std::uint32_t flags = frame_codec_detail::get_uint32(&out[frame_start]) & timeout_flag;
+        std::size_t prefix = flags ? header_size * 2 : header_size;
+        std::uint32_t length = static_cast<std::uint32_t>(out.size() - frame_start - prefix);
+        frame_codec_detail::put_uint32(out, frame_start, length | flags);
+    } else {
+        // 序列化后的 JSON 不含原始换行符，可直接作为分隔符
+        out.push_back('\n');
+    }
+}
+
+// ============================================================================
+// 解码
+// ============================================================================
+
+inline FrameCodec::Decoded FrameCodec::decode(Transport transport, const char* data, std::size_t size) {
+    Decoded decoded = { Status::NeedMore, 0, 0, 0, 0 };
+
+    if (transport == Transport::LengthPrefixed) {
+        if (size < header_size) {
+            return decoded;
+        }
+
+        std::uint32_t header = frame_codec_detail::get_uint32(data);
+        std::size_t length = header & ~timeout_flag;
+        std::size_t prefix = (header & timeout_flag) ? header_size * 2 : header_size;
+        if (length > max_frame_size) {
+            decoded.status = Status::TooLarge;
+            return decoded;
+        }
+        if (size < prefix || size - prefix < length) {
+            return decoded;
+        }
+
+        decoded.status = Status::Complete;
+        decoded.payload_offset = prefix;
+        decoded.payload_size = length;
+        decoded.consumed = prefix + length;
+        if (prefix != header_size) {
+            decoded.timeout_ms = frame_codec_detail::get_uint32(data + header_size);
+        }
+        return decoded;
+    }
+
+    // NDJSON：查找行尾
+    const void* newline = std::memchr(data, '\n', size);
+    if (!newline) {
+        if (size > max_frame_size) {
+            decoded.status = Status::TooLarge;
+        }
+        return decoded;
+    }
+
+    std::size_t line_size = static_cast<const char*>(newline) - data;
+    if (line_size > max_frame_size) {
+        decoded.status = Status::TooLarge;
+        return decoded;
+    }
+
+    decoded.status = Status::Complete;
+    decoded.consumed = line_size + 1;
+    // 兼容 CRLF 行尾
+    if (line_size > 0 && data[line_size - 1] == '\r') {
+        --line_size;
+    }
+
+    // 行首的 "@<毫秒数> " 是帧头携带的等待时间，格式不对时整行按负载交给 JSON 解析报错
+    if (line_size > 0 && data[0] == '@') {
+        const std::uint64_t limit = std::numeric_limits<std::uint32_t>::max();
+        std::size_t pos = 1;
+        std::uint64_t millis = 0;
+        while (pos < line_size && data[pos] >= '0' && data[pos] <= '9' && millis <= limit) {
+            millis = millis * 10 + static_cast<std::uint64_t>(data[pos] - '0');
+            ++pos;
+        }
+        if (pos > 1 && pos < line_size && data[pos] == ' ') {
+            decoded.timeout_ms = static_cast<std::uint32_t>(std::min(millis, limit));
+            decoded.payload_offset = pos + 1;
+            line_size -= pos + 1;
+        }
+    }
+    decoded.payload_size = line_size;
+    return decoded;
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,646 @@
+#pragma once
+
+#include <jsonrpc/detail/framed_client_session.hpp>
+#include <jsonrpc/detail/protocol.hpp>
+#include <jsonrpc/detail/transport_error.hpp>
+#include <jsonrpc/errors.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造函数
+// ============================================================================
+
+inline FramedClientSession::FramedClientSession(
+    boost::asio::io_context& io_context,
+    const std::string& host,
+    const std::string& port,
+    std::chrono::milliseconds timeout,
+    std::function<void(const std::string&)> logger,
+    Transport transport,
+    std::shared_ptr<EndpointCache> endpoint_cache)
+    : io_context_(io_context)
+    , strand_(boost::asio::make_strand(io_context))
+    , resolver_(strand_)
+    , stream_(strand_)
+    , host_(host)
+    , port_(port)
+    , timeout_(timeout)
+    , logger_(std::move(logger))
+    , transport_(transport)
+    , endpoint_cache_(std::move(endpoint_cache))
+    , state_(State::Disconnected)
+    , writing_(false)
+    , reading_(false)
+    , generation_(0)
+    , timer_(strand_)
+    , timer_armed_(false)
+{
+}
+
+inline void FramedClientSession::log(const std::string& message) const {
+    if (logger_) {
+        logger_(message);
+    }
+}
+
+inline void FramedClientSession::append_frame(Transport transport,
+                                             const std::string& host,
+                                             const std::string& json,
+                                             std::string& out,
+                                             std::chrono::milliseconds timeout)
+{
+    // 调用方的等待时间放在传输层（HTTP 头 / 帧头），JSON-RPC 消息保持标准格式
+    if (transport == Transport::Http) {
+        out.reserve(out.size() + json.size() + 192);
+        out.append("POST / HTTP/1.1\r\nHost: ").append(http_host_header(host));
+        out.append("\r\nContent-Type: application/json\r\nUser-Agent: jsonrpc-client\r\n");
+        if (timeout.count() > 0) {
+            out.append(timeout_header).append(": ").append(std::to_string(timeout.count())).append("\r\n");
+        }
+        out.append("Content-Length: ").append(std::to_string(json.size())).append("\r\n\r\n").append(json);
+        return;
+    }
+
+    std::size_t frame_start = FrameCodec::begin_frame(transport, out, timeout);
+    out.append(json);
+    FrameCodec::end_frame(transport, out, frame_start);
+}
+
+inline std::string FramedClientSession::encode(const std::string& json, std::chrono::milliseconds timeout) const {
+    std::string frame;
+    append_frame(transport_, host_, json, frame, timeout);
+    return frame;
+}
+
+// ============================================================================
+// 同步调用
+// ============================================================================
+
+inline Response FramedClientSession::call(const Request& request) {
+    std::string reply = exchange_sync(encode(Protocol::serialize_request(request), timeout_), true);
+
+    try {
+        return Protocol::parse_response(reply);
+    } catch (const Error& e) {
+        log(std::string("解析响应失败: ") + e.what());
+        throw;
+    }
+}
+
+inline std::vector<Response> FramedClientSession::call_batch(const std::vector<Request>& requests) {
+    // 全部为通知时服务端不会写回任何帧
+    bool expect_reply = false;
+    for (const auto& request : requests) {
+        expect_reply = expect_reply || request.has_id();
+    }
+
+    std::string reply = exchange_sync(encode(Protocol::serialize_batch_request(requests), timeout_), expect_reply);
+    if (!expect_reply) {
+        return {};
+    }
+
+    try {
+        return Protocol::parse_batch_response(reply);
+    } catch (const Error& e) {
+        log(std::string("解析批量响应失败: ") + e.what());
+        throw;
+    }
+}
+
+inline void FramedClientSession::notify(const Request& request) {
+    try {
+        exchange_sync(encode(Protocol::serialize_request(request), std::chrono::milliseconds(0)), false);
+    } catch (...) {
+        // 通知类型的请求，忽略错误
+    }
+}
+
+inline std::string FramedClientSession::exchange_sync(const std::string& frame, bool expect_reply) {
+    try {
+        // 解析域名并连接
+        auto const endpoints = resolve_endpoints(resolver_, host_, port_, endpoint_cache_);
+        stream_.expires_after(timeout_);
+        try {
+            stream_.connect(endpoints);
+        } catch (const boost::system::system_error&) {
+            if (endpoint_cache_) {
+                endpoint_cache_->invalidate(host_, port_);
+            }
+            throw;
+        }
+
+        // 发送请求帧
+        stream_.expires_after(timeout_);
+        boost::asio::write(stream_, boost::asio::buffer(frame));
+
+        std::string reply;
+        while (expect_reply) {
+            auto data = buffer_.data();
+            const char* bytes = static_cast<const char*>(data.data());
+            FrameCodec::Decoded decoded = FrameCodec::decode(transport_, bytes, data.size());
+
+            if (decoded.status == FrameCodec::Status::TooLarge) {
+                throw Error(ErrorCode::InternalError, "响应帧过大");
+            }
+            if (decoded.status == FrameCodec::Status::Complete) {
+                reply.assign(bytes + decoded.payload_offset, decoded.payload_size);
+                buffer_.consume(decoded.consumed);
+                if (!reply.empty()) {
+                    break;
+                }
+                continue;
+            }
+
+            // 数据不足一帧，继续读取
+            stream_.expires_after(timeout_);
+            std::size_t bytes_read = stream_.read_some(buffer_.prepare(64 * 1024));
+            buffer_.commit(bytes_read);
+        }
+
+        boost::beast::error_code ec;
+        stream_.socket().shutdown(boost::asio::socket_base::shutdown_both, ec);
+
+        return reply;
+
+    } catch (const boost::system::system_error& e) {
+        log(std::string("网络错误: ") + e.what());
+        throw transport_error(e.what());
+    }
+}
+
+// ============================================================================
+// 异步调用
+// ============================================================================
+
+inline void FramedClientSession::async_call(const Request& request,
+                                            std::chrono::milliseconds timeout,
+                                            Callback callback)
+{
+    // 在调用方线程序列化，strand 上只做排队与匹配；帧头携带本端的等待时间，服务端据此丢弃过期请求
+    std::string frame = encode(Protocol::serialize_request(request), timeout);
+    std::int64_t id = request.id().as_int64();
+
+    boost::asio::post(strand_, std::bind(&FramedClientSession::start_call, shared_from_this(),
+                                         id, timeout, std::move(callback), std::move(frame)));
+}
+
+inline void FramedClientSession::async_call_batch(const std::vector<Request>& requests,
+                                                  std::chrono::milliseconds timeout,
+                                                  std::vector<Callback> callbacks)
+{
+    std::string frame = encode(Protocol::serialize_batch_request(requests), timeout);
+    std::vector<std::int64_t> ids;
+    ids.reserve(requests.size());
+    for (const auto& request : requests) {
+        ids.push_back(request.id().as_int64());
+    }
+
+    boost::asio::post(strand_, std::bind(&FramedClientSession::start_batch, shared_from_this(),
+                                         std::move(ids), timeout, std::move(callbacks), std::move(frame)));
+}
+
+inline void FramedClientSession::async_notify(const Request& request) {
+    std::string frame = encode(Protocol::serialize_request(request), std::chrono::milliseconds(0));
+    boost::asio::post(strand_, std::bind(&FramedClientSession::start_notify, shared_from_this(),
+                                         std::move(frame)));
+}
+
+inline void FramedClientSession::start_call(std::int64_t id,
+                                            std::chrono::milliseconds timeout,
+                                            Callback& callback,
+                                            std::string& frame)
+{
+    PendingCall call;
+    call.callback = std::move(callback);
+    call.deadline = std::chrono::steady_clock::now() + timeout;
+    arm_timer(call.deadline);
+    pending_.insert(id, std::move(call));
+
+    queue_frame(frame);
+    if (transport_ == Transport::Http) {
+        http_order_.push_back(id);
+    }
+    if (state_ == State::Connected) {
+        do_read();
+    }
+}
+
+inline void FramedClientSession::start_batch(std::vector<std::int64_t>& ids,
+                                             std::chrono::milliseconds timeout,
+                                             std::vector<Callback>& callbacks,
+                                             std::string& frame)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    arm_timer(deadline);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        PendingCall call;
+        call.callback = std::move(callbacks[i]);
+        call.deadline = deadline;
+        pending_.insert(ids[i], std::move(call));
+    }
+
+    queue_frame(frame);
+    if (state_ == State::Connected) {
+        do_read();
+    }
+}
+
+inline void FramedClientSession::start_notify(std::string& frame) {
+    queue_frame(frame);
+    if (transport_ == Transport::Http) {
+        // 服务端对通知也会返回一个（空的）HTTP 响应，需要占位以保持顺序，并及时读走，
+        // 否则它留在套接字中，下次空闲探测无法区分对端关闭与未读数据
+        http_order_.push_back(no_reply_id);
+        if (state_ == State::Connected) {
+            do_read();
+        }
+    }
+}
+
+inline void FramedClientSession::queue_frame(std::string& frame) {
+    // 空闲期间对端可能已关闭连接（如服务端 keep-alive 超时），写出前检查，避免请求写进已关闭的连接
+    if (state_ == State::Connected && !writing_ && !reading_ &&
+        probe_socket(stream_.socket()) == SocketProbe::Closed) {
+        reset_connection();
+    }
+
+    write_queue_.push_back(std::move(frame));
+
+    if (state_ == State::Disconnected) {
+        do_connect();
+    } else if (state_ == State::Connected && !writing_) {
+        do_write();
+    }
+}
+
+// ============================================================================
+// 连接
+// ============================================================================
+
+inline void FramedClientSession::reset_connection() {
+    // 旧连接上挂起的操作完成时代数已不同，回调直接忽略，不会影响之后建立的新连接
+    ++generation_;
+    writing_ = false;
+    reading_ = false;
+
+    state_ = State::Disconnected;
+    boost::system::error_code ignored;
+    stream_.socket().close(ignored);
+    buffer_.clear();
+    http_parser_.reset();
+    http_order_.clear();
+}
+
+inline void FramedClientSession::do_connect() {
+    state_ = State::Connecting;
+    buffer_.clear();
+
+    auto self = shared_from_this();
+    std::uint64_t generation = generation_;
+    async_resolve_endpoints(resolver_, host_, port_, endpoint_cache_,
+        [self, generation](boost::system::error_code ec, endpoint_list endpoints) {
+            // 解析回调不在 strand 上，先切回 strand
+            boost::asio::post(self->strand_, [self, generation, ec, endpoints]() {
+                if (generation != self->generation_) {
+                    return;
+                }
+                if (ec) {
+                    self->fail_all("解析域名失败: " + ec.message());
+                    return;
+                }
+
+                self->stream_.async_connect(endpoints, boost::asio::bind_executor(self->strand_,
+                    [self, generation](boost::system::error_code ec, stream_protocol::endpoint) {
+                        if (generation != self->generation_) {
+                            return;
+                        }
+                        if (ec) {
+                            if (self->endpoint_cache_) {
+                                self->endpoint_cache_->invalidate(self->host_, self->port_);
+                            }
+                            self->fail_all("连接失败: " + ec.message());
+                            return;
+                        }
+                        self->on_connected();
+                    }
+                ));
+            });
+        }
+    );
+}
+
+inline void FramedClientSession::on_connected() {
+    state_ = State::Connected;
+
+    if (!write_queue_.empty() && !writing_) {
+        do_write();
+    }
+    if (awaiting_reply()) {
+        do_read();
+    }
+}
+
+// ============================================================================
+// 写出请求帧（排队中的帧合并为一次写入）
+// ============================================================================
+
+inline void FramedClientSession::do_write() {
+    writing_ = true;
+
+    // 帧由写操作自己持有：连接重置后旧的写操作仍可能引用它们
+    auto frames = std::make_shared<std::vector<std::string>>();
+    frames->swap(write_queue_);
+
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(frames->size());
+    for (const auto& frame : *frames) {
+        buffers.push_back(boost::asio::buffer(frame));
+    }
+
+    auto self = shared_from_this();
+    std::uint64_t generation = generation_;
+    boost::asio::async_write(stream_, buffers, boost::asio::bind_executor(strand_,
+        [self, frames, generation](boost::system::error_code ec, std::size_t) {
+            if (generation != self->generation_) {
+                return;
+            }
+            self->writing_ = false;
+            if (ec) {
+                self->fail_all("写入请求失败: " + ec.message());
+                return;
+            }
+            if (!self->write_queue_.empty()) {
+                self->do_write();
+            }
+        }
+    ));
+}
+
+// ============================================================================
+// 读取响应帧（只在有在途调用时读取）
+// ============================================================================
+
+inline void FramedClientSession::do_read() {
+    if (reading_) {
+        return;
+    }
+    reading_ = true;
+
+    auto self = shared_from_this();
+    std::uint64_t generation = generation_;
+    stream_.async_read_some(buffer_.prepare(64 * 1024), boost::asio::bind_executor(strand_,
+        [self, generation](boost::system::error_code ec, std::size_t bytes_transferred) {
+            if (generation != self->generation_) {
+                return;
+            }
+            self->on_read(ec, bytes_transferred);
+        }
+    ));
+}
+
+inline void FramedClientSession::on_read(boost::system::error_code ec, std::size_t bytes_transferred) {
+    reading_ = false;
+
+    if (ec) {
+        fail_all("读取响应失败: " + ec.message());
+        return;
+    }
+
+    buffer_.commit(bytes_transferred);
+
+    bool ok = (transport_ == Transport::Http) ? read_http_responses() : read_frames();
+    if (!ok) {
+        return;
+    }
+
+    if (state_ == State::Connected && awaiting_reply()) {
+        do_read();
+    }
+}
+
+inline bool FramedClientSession::awaiting_reply() const {
+    return !pending_.empty() || !http_order_.empty();
+}
+
+inline bool FramedClientSession::read_frames() {
+    while (state_ == State::Connected) {
+        auto data = buffer_.data();
+        const char* bytes = static_cast<const char*>(data.data());
+        FrameCodec::Decoded decoded = FrameCodec::decode(transport_, bytes, data.size());
+
+        if (decoded.status == FrameCodec::Status::NeedMore) {
+            break;
+        }
+        if (decoded.status == FrameCodec::Status::TooLarge) {
+            fail_all("响应帧过大");
+            return false;
+        }
+
+        if (decoded.payload_size > 0) {
+            handle_frame(boost::json::string_view(bytes + decoded.payload_offset, decoded.payload_size));
+        }
+        buffer_.consume(decoded.consumed);
+    }
+    return true;
+}
+
+inline bool FramedClientSession::read_http_responses() {
+    while (state_ == State::Connected && buffer_.size() > 0) {
+        if (!http_parser_) {
+            http_parser_.reset(new response_parser());
+            http_parser_->eager(true);
+            std::uint64_t body_limit = FrameCodec::max_frame_size;
+            http_parser_->body_limit(body_limit);
+        }
+
+        boost::beast::error_code ec;
+        std::size_t used = http_parser_->put(buffer_.data(), ec);
+        buffer_.consume(used);
+
+        if (ec == boost::beast::http::error::need_more) {
+            break;
+        }
+        if (ec) {
+            fail_all("解析 HTTP 响应失败: " + ec.message());
+            return false;
+        }
+        if (!http_parser_->is_done()) {
+            break;
+        }
+
+        // 按写出顺序对应请求
+        boost::beast::http::response<boost::beast::http::string_body> response = http_parser_->release();
+        http_parser_.reset();
+        handle_http_response(response);
+    }
+    return true;
+}
+
+inline Response FramedClientSession::parse_http_body(std::int64_t id, const std::string& body) const {
+    try {
+        return Protocol::parse_response(body);
+    } catch (const Error& e) {
+        log(std::string("解析响应失败: ") + e.what());
+        return Response(e, boost::json::value(id));
+    }
+}
+
+inline void FramedClientSession::handle_http_response(
+    boost::beast::http::response<boost::beast::http::string_body>& response)
+{
+    if (http_order_.empty()) {
+        fail_all("收到多余的 HTTP 响应");
+        return;
+    }
+
+    std::int64_t id = http_order_.front();
+    http_order_.pop_front();
+    bool keep_alive = response.keep_alive();
+
+    if (id != no_reply_id) {
+        Response result = parse_http_body(id, response.body());
+        complete(id, result);
+    }
+
+    // 服务端要求关闭：其后已写出的请求不会再有响应
+    if (!keep_alive && state_ == State::Connected) {
+        if (pending_.empty()) {
+            reset_connection();
+        } else {
+            fail_all("服务端关闭了连接");
+        }
+    }
+}
+
+inline void FramedClientSession::handle_frame(boost::json::string_view payload) {
+    boost::json::value jv;
+    try {
+        jv = boost::json::parse(payload);
+    } catch (const std::exception& e) {
+        log(std::string("解析响应失败: ") + e.what());
+        return;
+    }
+
+    try {
+        // 批量响应中的每个元素各自按 id 匹配
+        if (jv.is_array()) {
+            for (const auto& elem : jv.as_array()) {
+                Response response = Response::from_json(elem);
+                complete_by_id(response);
+            }
+        } else {
+            Response response = Response::from_json(jv);
+            complete_by_id(response);
+        }
+    } catch (const Error& e) {
+        log(std::string("解析响应失败: ") + e.what());
+    }
+}
+
+inline void FramedClientSession::complete_by_id(const Response& response) {
+    const boost::json::value& id = response.id();
+    if (!id.is_int64()) {
+        log("收到无法匹配的响应（id 不是整数）");
+        return;
+    }
+    complete(id.as_int64(), response);
+}
+
+inline void FramedClientSession::complete(std::int64_t id, const Response& response) {
+    PendingCall call;
+    if (!pending_.take(id, call)) {
+        // 已超时的调用
+        return;
+    }
+
+    if (pending_.empty() && timer_armed_) {
+        timer_armed_ = false;
+        timer_.cancel();
+    }
+
+    call.callback(response);
+}
+
+// ============================================================================
+// 超时
+// ============================================================================
+
+inline void FramedClientSession::arm_timer(std::chrono::steady_clock::time_point deadline) {
+    // 已在等待更早（或相同）的截止时间时无需调整；更早的截止时间（如调用的超时更短）重新设置，
+    // expires_at() 会取消原来的等待
+    if (timer_armed_ && timer_.expiry() <= deadline) {
+        return;
+    }
+    timer_armed_ = true;
+
+    auto self = shared_from_this();
+    timer_.expires_at(deadline);
+    timer_.async_wait(boost::asio::bind_executor(strand_,
+        [self](boost::system::error_code ec) {
+            self->on_timer(ec);
+        }
+    ));
+}
+
+inline void FramedClientSession::on_timer(boost::system::error_code ec) {
+    if (ec == boost::asio::error::operation_aborted) {
+        return;
+    }
+    timer_armed_ = false;
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::pair<std::int64_t, Callback>> expired;
+    bool has_next = false;
+    std::chrono::steady_clock::time_point next_deadline;
+
+    std::vector<std::int64_t> expired_ids;
+    pending_.for_each([&](std::int64_t id, PendingCall& call) {
+        if (call.deadline <= now) {
+            expired_ids.push_back(id);
+        } else if (!has_next || call.deadline < next_deadline) {
+            next_deadline = call.deadline;
+            has_next = true;
+        }
+    });
+    for (std::int64_t id : expired_ids) {
+        PendingCall call;
+        pending_.take(id, call);
+        expired.emplace_back(id, std::move(call.callback));
+    }
+
+    if (has_next) {
+        arm_timer(next_deadline);
+    }
+
+    for (auto& entry : expired) {
+        Error error = transport_error("请求超时");
+        entry.second(Response(error, boost::json::value(entry.first)));
+    }
+}
+
+// ============================================================================
+// 连接失败：所有在途调用以错误完成
+// ============================================================================
+
+inline void FramedClientSession::fail_all(const std::string& reason) {
+    log(reason);
+
+    write_queue_.clear();
+    reset_connection();
+
+    if (timer_armed_) {
+        timer_armed_ = false;
+        timer_.cancel();
+    }
+
+    auto failed = pending_.drain();
+    for (auto& entry : failed) {
+        Error error = transport_error(reason);
+        entry.second.callback(Response(error, boost::json::value(entry.first)));
+    }
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <jsonrpc/detail/framed_server_session.hpp>
+#include <jsonrpc/detail/protocol.hpp>
+#include <jsonrpc/errors.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造函数
+// ============================================================================
+
+inline FramedServerSession::FramedServerSession(
+    stream_socket socket,
+    std::shared_ptr<MethodRegistry> registry,
+    std::function<void(const std::string&)> logger,
+    SessionOptions options,
+    Transport transport)
+    : socket_(std::move(socket))
+    , registry_(std::move(registry))
+    , logger_(std::move(logger))
+    , options_(options)
+    , transport_(transport)
+    , write_failed_(false)
+    , disconnected_(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+inline void FramedServerSession::log(const std::string& message) const {
+    if (logger_) {
+        logger_(message);
+    }
+}
+
+// ============================================================================
+// 启动会话
+// ============================================================================
+
+inline void FramedServerSession::start() {
+    do_read();
+}
+
+inline void FramedServerSession::close() {
+    boost::system::error_code ignored;
+    socket_.close(ignored);
+}
+
+// ============================================================================
+// 读取请求帧
+// ============================================================================
+
+inline void FramedServerSession::do_read() {
+    auto self = shared_from_this();
+    socket_.async_read_some(
+        buffer_.prepare(64 * 1024),
+        [self](boost::system::error_code ec, std::size_t bytes_transferred) {
+            self->on_read(ec, bytes_transferred);
+        }
+    );
+}
+
+inline void FramedServerSession::on_read(boost::system::error_code ec, std::size_t bytes_transferred) {
+    if (ec) {
+        // 对端关闭或出错：停止读取，取消尚未执行的请求（通知除外），结果不再写回。
+        // eof 也可能来自半关闭（shutdown 写方向），与完全关闭无法区分，同样视为放弃等待
+        if (ec != boost::asio::error::eof && ec != boost::asio::error::operation_aborted) {
+            log(std::string("读取请求失败: ") + ec.message());
+        }
+        disconnected_->store(true, std::memory_order_release);
+        return;
+    }
+
+    buffer_.commit(bytes_transferred);
+
+    // 取出所有完整的帧
+    while (true) {
+        auto data = buffer_.data();
+        const char* bytes = static_cast<const char*>(data.data());
+        FrameCodec::Decoded decoded = FrameCodec::decode(transport_, bytes, data.size());
+
+        if (decoded.status == FrameCodec::Status::NeedMore) {
+            break;
+        }
+        if (decoded.status == FrameCodec::Status::TooLarge) {
+            log("请求帧过大，关闭连接");
+            boost::system::error_code ignored;
+            socket_.shutdown(boost::asio::socket_base::shutdown_both, ignored);
+            socket_.close(ignored);
+            return;
+        }
+
+        if (decoded.payload_size > 0) {
+            process_frame(boost::json::string_view(bytes + decoded.payload_offset, decoded.payload_size),
+                          std::chrono::milliseconds(decoded.timeout_ms));
+        }
+        buffer_.consume(decoded.consumed);
+    }
+
+    do_read();
+}
+
+// ============================================================================
+// 处理一帧
+// ============================================================================
+
+inline void FramedServerSession::process_frame(boost::json::string_view payload,
+                                               std::chrono::milliseconds timeout) {
+    ParsedRequests parsed;
+    try {
+        parsed = Protocol::parse_requests(payload);
+    } catch (const Error& e) {
+        log(std::string("解析请求失败: ") + e.what());
+        std::string frame = encode_response(Response(e, boost::json::value(nullptr)));
+        send_frame(frame);
+        return;
+    }
+
+    // 请求需保持有效直到调用完成，由完成回调共同持有
+    auto requests = std::make_shared<std::vector<Request>>(std::move(parsed.requests));
+    auto self = shared_from_this();
+    InvokeContext context;
+    context.executor = socket_.get_executor();
+    // 排队超过调用方剩余等待时间或连接断开后，请求不再执行
+    context.call = CallContext(timeout.count() > 0 ? CallContext::clock::now() + timeout
+                                                   : CallContext::clock::time_point::max(),
+                               disconnected_);
+
+    if (!parsed.is_batch) {
+        const Request& request = requests->front();
+        bool has_id = request.has_id();
+
+        // 响应在完成线程上编码，再回到会话执行器排队写出
+        std::function<void(Response)> on_response = [self, requests, has_id](Response response) {
+            if (!has_id) {
+                return;
+            }
+            std::string frame = self->encode_response(response);
+            boost::asio::dispatch(self->socket_.get_executor(),
+                std::bind(&FramedServerSession::send_frame, self, std::move(frame)));
+        };
+
+        if (options_.inline_single_requests) {
+            registry_->begin_invoke(request, std::move(on_response), context);
+        } else {
+            registry_->async_invoke(request, std::move(on_response), context);
+        }
+        return;
+    }
+
+    registry_->async_invoke_batch(*requests, [self, requests](std::vector<Response> responses) {
+        // 全部为通知时不写回
+        if (responses.empty()) {
+            return;
+        }
+        std::string frame = self->encode_batch_response(responses);
+        boost::asio::dispatch(self->socket_.get_executor(),
+            std::bind(&FramedServerSession::send_frame, self, std::move(frame)));
+    }, context);
+}
+
+// ============================================================================
+// 编码响应
+// ============================================================================
+
+inline std::string FramedServerSession::encode_response(const Response& response) const {
+    std::string frame;
+    std::size_t frame_start = FrameCodec::begin_frame(transport_, frame);
+    Protocol::write_response(response, frame);
+    FrameCodec::end_frame(transport_, frame, frame_start);
+    return frame;
+}
+
+inline std::string FramedServerSession::encode_batch_response(const std::vector<Response>& responses) const {
+    std::string frame;
+    std::size_t frame_start = FrameCodec::begin_frame(transport_, frame);
+    Protocol::write_batch_response(responses, frame);
+    FrameCodec::end_frame(transport_, frame, frame_start);
+    return frame;
+}
+
+// ============================================================================
+// 写出响应帧
+// ============================================================================
+
+inline void FramedServerSession::send_frame(std::string& frame) {
+    if (write_failed_ || disconnected_->load(std::memory_order_acquire)) {
+        return;
+    }
+
+    write_queue_.push_back(std::move(frame));
+
+    // 正在写出时，本帧会在当前写入完成后与其他排队的帧一起写出
+    if (writing_.empty()) {
+        do_write();
+    }
+}
+
+inline void FramedServerSession::do_write() {
+    writing_.swap(write_queue_);
+
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(writing_.size());
+    for (const auto& frame : writing_) {
+        buffers.push_back(boost::asio::buffer(frame));
+    }
+
+    auto self = shared_from_this();
+    boost::asio::async_write(socket_, buffers,
+        [self](boost::system::error_code ec, std::size_t) {
+            self->on_write(ec);
+        }
+    );
+}
+
+inline void FramedServerSession::on_write(boost::system::error_code ec) {
+    writing_.clear();
+
+    if (ec) {
+        log(std::string("写入响应失败: ") + ec.message());
+        write_failed_ = true;
+        write_queue_.clear();
+        return;
+    }
+
+    if (!write_queue_.empty()) {
+        do_write();
+    }
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <jsonrpc/detail/hash_ring.hpp>
+#include <algorithm>
+
+namespace jsonrpc {
+namespace detail {
+
+inline HashRing::HashRing(std::size_t virtual_nodes)
+    : virtual_nodes_(virtual_nodes == 0 ? 1 : virtual_nodes)
+{
+}
+
+inline void HashRing::add(const std::string& name, std::size_t index) {
+    points_.reserve(points_.size() + virtual_nodes_);
+    for (std::size_t i = 0; i < virtual_nodes_; ++i) {
+        points_.emplace_back(hash(name + "#" + std::to_string(i)), index);
+    }
+    std::sort(points_.begin(), points_.end());
+}
+
+inline std::size_t HashRing::locate(const std::string& key) const {
+    if (points_.empty()) {
+        return 0;
+    }
+    std::uint64_t value = hash(key);
+    auto it = std::lower_bound(points_.begin(), points_.end(), value,
+        [](const std::pair<std::uint64_t, std::size_t>& point, std::uint64_t h) {
+            return point.first < h;
+        });
+    // 越过最后一个点时回到环首
+    if (it == points_.end()) {
+        it = points_.begin();
+    }
+    return it->second;
+}
+
+inline std::uint64_t HashRing::hash(const std::string& data) {
+    std::uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    // FNV-1a 的低位扩散较弱，末尾做一次 64 位混合
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <jsonrpc/detail/hedged_call.hpp>
+#include <jsonrpc/detail/transport_error.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// LatencyWindow
+// ============================================================================
+
+inline LatencyWindow::LatencyWindow(std::size_t capacity)
+    : capacity_(capacity == 0 ? 1 : capacity)
+    , next_(0)
+{
+    samples_.reserve(capacity_);
+}
+
+inline void LatencyWindow::record(std::chrono::steady_clock::duration latency) {
+    std::int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_.size() < capacity_) {
+        samples_.push_back(micros);
+        return;
+    }
+    samples_[next_] = micros;
+    next_ = (next_ + 1) % capacity_;
+}
+
+inline bool LatencyWindow::percentile(double percentile, std::chrono::steady_clock::duration& out) const {
+    // 样本太少时分位数没有意义
+    const std::size_t min_samples = 16;
+
+    std::vector<std::int64_t> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (samples_.size() < min_samples) {
+            return false;
+        }
+        sorted = samples_;
+    }
+
+    double rank = std::min(std::max(percentile, 0.0), 100.0) / 100.0 * static_cast<double>(sorted.size() - 1);
+    auto nth = sorted.begin() + static_cast<std::ptrdiff_t>(std::ceil(rank));
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    out = std::chrono::microseconds(*nth);
+    return true;
+}
+
+// ============================================================================
+// HedgedCall 构造与发起
+// ============================================================================
+
+inline void HedgedCall::start(boost::asio::io_context& io_context,
+                              const Request& request,
+                              const RetryPolicy& retry,
+                              const HedgePolicy& hedge,
+                              std::shared_ptr<LatencyWindow> latencies,
+                              Sender sender,
+                              std::function<boost::json::value()> next_id,
+                              Callback callback)
+{
+    auto call = std::make_shared<HedgedCall>(io_context, request, retry, hedge, std::move(latencies),
+                                             std::move(sender), std::move(next_id), std::move(callback));
+    boost::asio::dispatch(call->strand_, std::bind(&HedgedCall::begin_round, call));
+}
+
+inline HedgedCall::HedgedCall(boost::asio::io_context& io_context,
+                              const Request& request,
+                              const RetryPolicy& retry,
+                              const HedgePolicy& hedge,
+                              std::shared_ptr<LatencyWindow> latencies,
+                              Sender sender,
+                              std::function<boost::json::value()> next_id,
+                              Callback callback)
+    : strand_(boost::asio::make_strand(io_context))
+    , hedge_timer_(io_context)
+    , backoff_timer_(io_context)
+    , request_(request)
+    , retry_(retry)
+    , hedge_(hedge)
+    , hedge_delay_(hedge.min_delay)
+    , latencies_(std::move(latencies))
+    , sender_(std::move(sender))
+    , next_id_(std::move(next_id))
+    , callback_(std::move(callback))
+    , attempts_(0)
+    , hedges_(0)
+    , in_flight_(0)
+    , finished_(false)
+    , random_(std::random_device()())
+{
+    std::chrono::steady_clock::duration observed;
+    if (hedge_.max_hedges != 0 && latencies_ && latencies_->percentile(hedge_.percentile, observed)) {
+        hedge_delay_ = std::max<std::chrono::steady_clock::duration>(observed, hedge_.min_delay);
+    }
+}
+
+// ============================================================================
+// 每一轮：发出请求，超过对冲延迟仍无响应时发出副本
+// ============================================================================
+
+inline void HedgedCall::begin_round() {
+    ++attempts_;
+    hedges_ = 0;
+    launch(false);
+    arm_hedge();
+}
+
+inline void HedgedCall::launch(bool hedged) {
+    // 第一份请求沿用原 id，副本与重试换新 id，避免在同一条多路复用连接上冲突
+    bool original = attempts_ == 1 && !hedged;
+    Request copy(request_.method(), request_.params(), original ? request_.id() : next_id_());
+
+    ++in_flight_;
+    auto self = shared_from_this();
+    std::size_t round = attempts_;
+    auto sent = std::chrono::steady_clock::now();
+    sender_(copy, hedged, [self, round, sent](const Response& response) {
+        boost::asio::dispatch(self->strand_, std::bind(&HedgedCall::on_response, self, response, round, sent));
+    });
+}
+
+inline void HedgedCall::arm_hedge() {
+    if (finished_ || in_flight_ == 0 || hedges_ >= hedge_.max_hedges) {
+        return;
+    }
+    auto self = shared_from_this();
+    hedge_timer_.expires_after(hedge_delay_);
+    hedge_timer_.async_wait(boost::asio::bind_executor(strand_,
+        [self](boost::system::error_code ec) {
+            self->on_hedge_timer(ec);
+        }
+    ));
+}
+
+inline void HedgedCall::on_hedge_timer(boost::system::error_code ec) {
+    if (ec == boost::asio::error::operation_aborted || finished_ || in_flight_ == 0) {
+        return;
+    }
+    ++hedges_;
+    launch(true);
+    arm_hedge();
+}
+
+// ============================================================================
+// 响应处理
+// ============================================================================
+
+inline void HedgedCall::on_response(const Response& response, std::size_t round, std::chrono::steady_clock::time_point sent) {
+    if (finished_) {
+        return;
+    }
+
+    // 对冲副本因并发上限未能发出时，等待其余副本
+    bool overloaded = response.is_error() && response.error().code() == ErrorCode::Overloaded;
+    if (overloaded && round == attempts_ && in_flight_ > 1) {
+        --in_flight_;
+        return;
+    }
+
+    bool network_error = response.is_error() && is_transport_error(response.error());
+    if (!network_error) {
+        if (latencies_ && !response.is_error()) {
+            latencies_->record(std::chrono::steady_clock::now() - sent);
+        }
+        finish(response);
+        return;
+    }
+
+    // 上一轮残留的失败副本不影响当前轮
+    if (round != attempts_) {
+        return;
+    }
+    if (--in_flight_ != 0) {
+        return;
+    }
+
+    hedge_timer_.cancel();
+    if (attempts_ >= retry_.max_attempts) {
+        finish(response);
+        return;
+    }
+
+    auto self = shared_from_this();
+    backoff_timer_.expires_after(backoff());
+    backoff_timer_.async_wait(boost::asio::bind_executor(strand_,
+        [self](boost::system::error_code ec) {
+            self->on_backoff_timer(ec);
+        }
+    ));
+}
+
+inline void HedgedCall::on_backoff_timer(boost::system::error_code ec) {
+    if (ec == boost::asio::error::operation_aborted || finished_) {
+        return;
+    }
+    begin_round();
+}
+
+inline std::chrono::milliseconds HedgedCall::backoff() {
+    // full jitter：在 [0, 上限] 内均匀取值
+    double cap = static_cast<double>(retry_.initial_backoff.count())
+               * std::pow(retry_.multiplier, static_cast<double>(attempts_ - 1));
+    cap = std::min(cap, static_cast<double>(retry_.max_backoff.count()));
+    if (cap <= 0.0) {
+        return std::chrono::milliseconds(0);
+    }
+    std::uniform_int_distribution<std::int64_t> dist(0, static_cast<std::int64_t>(cap));
+    return std::chrono::milliseconds(dist(random_));
+}
+
+inline void HedgedCall::finish(const Response& response) {
+    finished_ = true;
+    hedge_timer_.cancel();
+    backoff_timer_.cancel();
+
+    Callback callback;
+    callback.swap(callback_);
+    if (response.is_error()) {
+        callback(Response(response.error(), request_.id()));
+    } else {
+        callback(Response(response.result(), request_.id()));
+    }
+}
+
+} // namespace detail
+} // namespace jsonrpc
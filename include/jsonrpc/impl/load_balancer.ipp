@@ -0,0 +1,166 @@
+#pragma once
+
+#include <jsonrpc/detail/load_balancer.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+inline LoadBalancer::LoadBalancer(std::size_t endpoint_count)
+    : states_(endpoint_count == 0 ? 1 : endpoint_count)
+    , policy_(LoadBalancePolicy::LeastOutstanding)
+    , cursor_(0)
+    , eject_after_(5)
+    , eject_duration_(std::chrono::seconds(10))
+    , random_(std::random_device()())
+{
+}
+
+inline void LoadBalancer::set_policy(LoadBalancePolicy policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+}
+
+inline LoadBalancePolicy LoadBalancer::policy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return policy_;
+}
+
+inline void LoadBalancer::set_ejection(std::size_t consecutive_failures, std::chrono::milliseconds duration) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    eject_after_ = consecutive_failures;
+    eject_duration_ = duration;
+    if (eject_after_ == 0) {
+        for (auto& state : states_) {
+            state.ejected_until = std::chrono::steady_clock::time_point();
+        }
+    }
+}
+
+// ============================================================================
+// 选择端点
+// ============================================================================
+
+inline bool LoadBalancer::available(const State& state, std::chrono::steady_clock::time_point now) const {
+    return state.ejected_until <= now;
+}
+
+inline double LoadBalancer::cost(const State& state) const {
+    // 尚无延迟样本的端点代价最低，优先探测
+    return static_cast<double>(state.outstanding + 1) * state.latency_us;
+}
+
+inline std::size_t LoadBalancer::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t index = states_.size() == 1 ? 0 : pick(std::chrono::steady_clock::now());
+    ++states_[index].outstanding;
+    return index;
+}
+
+inline std::size_t LoadBalancer::pick(std::chrono::steady_clock::time_point now) {
+    std::vector<std::size_t> candidates;
+    candidates.reserve(states_.size());
+    for (std::size_t i = 0; i < states_.size(); ++i) {
+        if (available(states_[i], now)) {
+            candidates.push_back(i);
+        }
+    }
+    // 全部被摘除时退化为在所有端点中选择
+    if (candidates.empty()) {
+        for (std::size_t i = 0; i < states_.size(); ++i) {
+            candidates.push_back(i);
+        }
+    }
+
+    std::size_t start = cursor_++ % candidates.size();
+
+    switch (policy_) {
+    case LoadBalancePolicy::RoundRobin:
+        return candidates[start];
+
+    case LoadBalancePolicy::PowerOfTwoChoices: {
+        if (candidates.size() == 1) {
+            return candidates.front();
+        }
+        std::uniform_int_distribution<std::size_t> dist(0, candidates.size() - 1);
+        std::size_t a = dist(random_);
+        std::size_t b = dist(random_);
+        while (b == a) {
+            b = dist(random_);
+        }
+        const State& first = states_[candidates[a]];
+        const State& second = states_[candidates[b]];
+        return cost(second) < cost(first) ? candidates[b] : candidates[a];
+    }
+
+    case LoadBalancePolicy::LeastOutstanding:
+    default: {
+        // 从轮询位置开始扫描，在途数相同时依次轮换
+        std::size_t best = candidates[start];
+        for (std::size_t n = 1; n < candidates.size(); ++n) {
+            std::size_t index = candidates[(start + n) % candidates.size()];
+            if (states_[index].outstanding < states_[best].outstanding) {
+                best = index;
+            }
+        }
+        return best;
+    }
+    }
+}
+
+// ============================================================================
+// 完成统计
+// ============================================================================
+
+inline void LoadBalancer::release(std::size_t index, bool succeeded, std::chrono::steady_clock::duration latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    State& state = states_[index];
+    if (state.outstanding > 0) {
+        --state.outstanding;
+    }
+
+    if (succeeded) {
+        const double alpha = 0.2;
+        double sample = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+        state.latency_us = state.latency_us == 0.0 ? sample : state.latency_us + alpha * (sample - state.latency_us);
+        state.failures = 0;
+        return;
+    }
+
+    ++state.failures;
+    if (eject_after_ != 0 && state.failures >= eject_after_) {
+        state.ejected_until = std::chrono::steady_clock::now() + eject_duration_;
+        // 期满重新加入后，再失败一次即再次摘除
+        state.failures = eject_after_ - 1;
+    }
+}
+
+inline void LoadBalancer::cancel(std::size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    State& state = states_[index];
+    if (state.outstanding > 0) {
+        --state.outstanding;
+    }
+}
+
+inline EndpointStatus LoadBalancer::status(std::size_t index) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const State& state = states_[index];
+
+    EndpointStatus status;
+    status.endpoint.port = 0;
+    status.outstanding = state.outstanding;
+    status.latency = std::chrono::microseconds(static_cast<std::int64_t>(state.latency_us));
+    status.consecutive_failures = state.failures;
+    status.ejected = !available(state, std::chrono::steady_clock::now());
+    status.concurrency_limit = 0;
+    status.queued = 0;
+    return status;
+}
+
+} // namespace detail
+} // namespace jsonrpc
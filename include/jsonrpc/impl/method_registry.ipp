@@ -13,7 +13,10 @@ namespace detail {
 // ============================================================================
 
 inline MethodRegistry::MethodRegistry()
-    : batch_thread_count_(std::max<std::size_t>(2, std::thread::hardware_concurrency()))
+    : read_only_(false)
+    , shut_down_(false)
+    , replies_(std::make_shared<ReplyTracker>())
+    , batch_thread_count_(std::max<std::size_t>(2, std::thread::hardware_concurrency()))
     , batch_pool_(std::make_shared<boost::asio::thread_pool>(static_cast<unsigned>(batch_thread_count_)))
 {
 }
@@ -29,137 +32,352 @@ inline void MethodRegistry::set_batch_concurrency(std::size_t threads) {
         batch_pool_->stop();
         batch_pool_->join();
     }
+    // 被 stop() 丢弃的占位任务不会再执行，对应的排队任务一并丢弃
+    scheduler_.clear();
     batch_pool_.reset(new boost::asio::thread_pool(static_cast<unsigned>(batch_thread_count_)));
 }
 
+inline void MethodRegistry::set_method_priority(const std::string& name, Priority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (read_only_.load(std::memory_order_relaxed)) {
+        throw std::logic_error("方法表处于只读状态，无法设置优先级: " + name);
+    }
+    priorities_[name] = priority;
+}
+
+inline void MethodRegistry::set_priority_scheduling(const SchedulingPolicy& policy) {
+    scheduler_.set_policy(policy);
+}
+
+inline void MethodRegistry::set_read_only(bool read_only) {
+    // 与 invoke() 中加锁的查找路径互斥，保证切换前的注册对只读查找可见
+    std::lock_guard<std::mutex> lock(mutex_);
+    read_only_.store(read_only, std::memory_order_release);
+}
+
+inline bool MethodRegistry::is_read_only() const {
+    return read_only_.load(std::memory_order_acquire);
+}
+
 inline std::shared_ptr<boost::asio::thread_pool> MethodRegistry::get_batch_pool() {
     std::lock_guard<std::mutex> lock(pool_mutex_);
-    if (!batch_pool_) {
+    if (!batch_pool_ && !shut_down_.load(std::memory_order_acquire)) {
         batch_pool_ = std::make_shared<boost::asio::thread_pool>(static_cast<unsigned>(batch_thread_count_));
     }
     return batch_pool_;
 }
 
+inline void MethodRegistry::drain() {
+    std::shared_ptr<boost::asio::thread_pool> pool;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool = std::move(batch_pool_);
+    }
+    if (pool) {
+        // 未调用 stop()，join() 会等待所有已投递任务执行完毕
+        pool->join();
+    }
+}
+
+inline void MethodRegistry::shutdown() {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    shut_down_.store(true, std::memory_order_release);
+}
+
+inline std::size_t MethodRegistry::outstanding() const {
+    std::lock_guard<std::mutex> lock(replies_->mutex);
+    return replies_->pending.size();
+}
+
+inline void MethodRegistry::abandon_outstanding() {
+    std::vector<std::shared_ptr<PendingReply>> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(replies_->mutex);
+        for (const auto& entry : replies_->pending) {
+            if (auto reply = entry.lock()) {
+                abandoned.push_back(std::move(reply));
+            }
+        }
+    }
+
+    // 持有 reply->mutex 时清空：正在执行的回复先完成，之后的回复看到空回调直接丢弃
+    for (const auto& reply : abandoned) {
+        std::lock_guard<std::mutex> lock(reply->mutex);
+        reply->handler = nullptr;
+    }
+}
+
 // ============================================================================
 // 注册方法
 // ============================================================================
 
 template<typename Func>
 void MethodRegistry::register_method(const std::string& name, Func&& func) {
-    auto wrapper = std::make_shared<MethodWrapperImpl<typename std::decay<Func>::type>>(
+    typedef typename select_method_wrapper<typename std::decay<Func>::type>::type wrapper_type;
+    add_method(name, std::make_shared<wrapper_type>(
         std::forward<Func>(func)
-    );
+    ));
+}
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    methods_[name] = wrapper;
+template<typename Func>
+void MethodRegistry::register_async_method(const std::string& name, Func&& func) {
+    add_method(name, std::make_shared<AsyncMethodWrapperImpl<typename std::decay<Func>::type>>(
+        std::forward<Func>(func)
+    ));
 }
 
-// ============================================================================
-// 调用方法
-// ============================================================================
+inline void MethodRegistry::add_method(const std::string& name, std::shared_ptr<MethodWrapperBase> wrapper) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (read_only_.load(std::memory_order_relaxed)) {
+        throw std::logic_error("方法表处于只读状态，无法注册方法: " + name);
+    }
+    methods_[name] = std::move(wrapper);
+}
 
-inline Response MethodRegistry::invoke(const Request& request) {
-    const std::string& method_name = request.method();
-    const boost::json::value& params = request.params();
-    const boost::json::value& id = request.id();
+inline MethodWrapperBase* MethodRegistry::find_method(const std::string& name,
+                                                      std::shared_ptr<MethodWrapperBase>& holder) {
+    // 只读模式下 methods_ 不会变化，直接查找避免锁和引用计数竞争
+    if (read_only_.load(std::memory_order_acquire)) {
+        auto it = methods_.find(name);
+        return it != methods_.end() ? it->second.get() : nullptr;
+    }
 
-    try {
-        // 查找方法
-        std::shared_ptr<MethodWrapperBase> wrapper;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = methods_.find(method_name);
-            if (it == methods_.end()) {
-                throw Error(ErrorCode::MethodNotFound,
-                    "方法不存在: " + method_name);
-            }
-            wrapper = it->second;
-        }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = methods_.find(name);
+    if (it == methods_.end()) {
+        return nullptr;
+    }
+    holder = it->second;
+    return holder.get();
+}
 
-        // 调用方法
-        boost::json::value result = wrapper->invoke(params);
+inline Priority MethodRegistry::priority_of(const Request& request, const InvokeContext& context) {
+    if (context.priority) {
+        return *context.priority;
+    }
 
-        // 构造成功响应
-        return Response(result, id);
+    // 与 find_method 相同：只读模式下 priorities_ 不会变化，直接查找
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!read_only_.load(std::memory_order_acquire)) {
+        lock.lock();
+    }
+    if (priorities_.empty()) {
+        return Priority::Normal;
+    }
+    auto it = priorities_.find(request.method());
+    return it != priorities_.end() ? it->second : Priority::Normal;
+}
 
+inline Response MethodRegistry::make_error_response(std::exception_ptr error, const boost::json::value& id) {
+    try {
+        std::rethrow_exception(error);
     } catch (const Error& e) {
         // JSON-RPC 错误，直接返回错误响应
         return Response(e, id);
     } catch (const std::exception& e) {
         // 其他异常，转换为 InternalError
-        Error error(ErrorCode::InternalError,
-            std::string("内部错误: ") + e.what());
-        return Response(error, id);
+        return Response(Error(ErrorCode::InternalError, std::string("内部错误: ") + e.what()), id);
+    } catch (...) {
+        return Response(Error(ErrorCode::InternalError, "内部错误: 未知异常"), id);
     }
 }
 
 // ============================================================================
-// 批量调用方法
+// 调用方法
 // ============================================================================
 
-inline std::vector<Response> MethodRegistry::invoke_batch(const std::vector<Request>& requests) {
-    if (requests.empty()) {
-        return {};
+inline Response MethodRegistry::invoke(const Request& request) {
+    // 请求可能位于会话的单次请求内存区，响应中的 id 拷贝到默认存储
+    boost::json::value id(request.id(), boost::json::storage_ptr());
+
+    try {
+        std::shared_ptr<MethodWrapperBase> holder;
+        MethodWrapperBase* wrapper = find_method(request.method(), holder);
+        if (!wrapper) {
+            throw Error(ErrorCode::MethodNotFound,
+                "方法不存在: " + request.method());
+        }
+
+        // 调用方法并构造成功响应
+        return Response(wrapper->invoke(request.params()), id);
+
+    } catch (...) {
+        return make_error_response(std::current_exception(), id);
     }
+}
 
-    auto pool = get_batch_pool();
-    struct IndexedResponse {
-        std::size_t index;
-        Response response;
-    };
+inline void MethodRegistry::begin_invoke(const Request& request, std::function<void(Response)> handler,
+                                         const InvokeContext& context) {
+    // 请求可能位于会话的单次请求内存区（非线程安全），id 拷贝到默认存储
+    boost::json::value id(request.id(), boost::json::storage_ptr());
 
-    std::mutex response_mutex;
-    std::vector<IndexedResponse> indexed_responses;
-    indexed_responses.reserve(requests.size());
+    if (shut_down_.load(std::memory_order_acquire)) {
+        handler(Response(Error(ErrorCode::ServerError, "服务器正在关闭，请求未执行: " + request.method()), id));
+        return;
+    }
 
-    auto remaining = std::make_shared<std::atomic<std::size_t>>(requests.size());
-    auto completion_promise = std::make_shared<std::promise<void>>();
-    auto completion_future = completion_promise->get_future();
+    // 在线程池中排队期间调用方已放弃等待：不再执行
+    if (context.call.expired()) {
+        handler(Response(Error(ErrorCode::DeadlineExceeded, "请求已超过调用方的截止时间: " + request.method()), id));
+        return;
+    }
 
-    for (std::size_t idx = 0; idx < requests.size(); ++idx) {
-        Request request_copy = requests[idx];
-
-        boost::asio::post(*pool, [this, idx, request_copy, &indexed_responses, &response_mutex, remaining, completion_promise]() mutable {
-            Request request = std::move(request_copy);
-            try {
-                if (request.has_id()) {
-                    Response resp = invoke(request);
-                    std::lock_guard<std::mutex> lock(response_mutex);
-                    indexed_responses.push_back(IndexedResponse{idx, std::move(resp)});
+    // 通知没有响应，客户端发送后断开连接不代表放弃，照常执行且不可取消
+    const InvokeContext* invoke_context = &context;
+    InvokeContext detached;
+    if (!request.has_id()) {
+        detached.executor = context.executor;
+        detached.call = CallContext(context.call.deadline());
+        invoke_context = &detached;
+    } else if (context.call.cancelled()) {
+        // 客户端已断开，尚未开始执行的请求直接丢弃
+        handler(Response(Error(ErrorCode::ServerError, "客户端已断开，请求未执行: " + request.method()), id));
+        return;
+    }
+
+    std::shared_ptr<MethodWrapperBase> holder;
+    MethodWrapperBase* wrapper = find_method(request.method(), holder);
+    if (!wrapper) {
+        handler(Response(Error(ErrorCode::MethodNotFound, "方法不存在: " + request.method()), id));
+        return;
+    }
+
+    if (!wrapper->completes_later()) {
+        wrapper->async_invoke(request.params(), *invoke_context,
+            [id, handler](std::exception_ptr error, boost::json::value result) {
+                if (error) {
+                    handler(make_error_response(error, id));
                 } else {
-                    invoke(request);
+                    handler(Response(std::move(result), id));
                 }
-            } catch (...) {
-                if (request.has_id()) {
-                    Response error_response(Error(ErrorCode::InternalError, "批量调用失败"), request.id());
-                    std::lock_guard<std::mutex> lock(response_mutex);
-                    indexed_responses.push_back(IndexedResponse{idx, std::move(error_response)});
+            });
+        return;
+    }
+
+    // 异步方法的 Responder 可能在线程池之外（定时器、其他线程）回复，drain() 无法覆盖，登记到回复表
+    auto reply = std::make_shared<PendingReply>();
+    reply->handler = std::move(handler);
+    {
+        std::lock_guard<std::mutex> lock(replies_->mutex);
+        reply->position = replies_->pending.insert(replies_->pending.end(), reply);
+    }
+
+    std::weak_ptr<ReplyTracker> tracker = replies_;
+    wrapper->async_invoke(request.params(), *invoke_context,
+        [id, reply, tracker](std::exception_ptr error, boost::json::value result) {
+            {
+                std::lock_guard<std::mutex> lock(reply->mutex);
+                if (reply->handler) {
+                    std::function<void(Response)> handler = std::move(reply->handler);
+                    reply->handler = nullptr;
+                    if (error) {
+                        handler(make_error_response(error, id));
+                    } else {
+                        handler(Response(std::move(result), id));
+                    }
                 }
             }
 
-            if (remaining->fetch_sub(1) == 1) {
-                completion_promise->set_value();
+            // 注册表已销毁时无需移除
+            if (auto replies = tracker.lock()) {
+                std::lock_guard<std::mutex> lock(replies->mutex);
+                replies->pending.erase(reply->position);
             }
         });
+}
+
+// ============================================================================
+// 单个请求异步调用
+// ============================================================================
+
+inline void MethodRegistry::async_invoke(const Request& request, std::function<void(Response)> handler,
+                                         const InvokeContext& context) {
+    auto pool = get_batch_pool();
+    if (!pool) {
+        // 已 shutdown()：begin_invoke() 直接以错误完成
+        begin_invoke(request, std::move(handler), context);
+        return;
     }
+    const Request* target = &request;
+    scheduler_.post(*pool, priority_of(request, context), [this, target, handler, context]() {
+        begin_invoke(*target, handler, context);
+    });
+}
 
-    completion_future.wait();
+// ============================================================================
+// 批量调用方法
+// ============================================================================
 
-    std::sort(
-        indexed_responses.begin(),
-        indexed_responses.end(),
-        [](const IndexedResponse& a, const IndexedResponse& b) {
-            return a.index < b.index;
-        }
-    );
+inline std::vector<Response> MethodRegistry::invoke_batch(const std::vector<Request>& requests) {
+    if (requests.empty()) {
+        return {};
+    }
+
+    auto completion_promise = std::make_shared<std::promise<std::vector<Response>>>();
+    auto completion_future = completion_promise->get_future();
+
+    async_invoke_batch(requests, [completion_promise](std::vector<Response> responses) {
+        completion_promise->set_value(std::move(responses));
+    });
 
-    std::vector<Response> responses;
-    responses.reserve(indexed_responses.size());
-    for (auto& entry : indexed_responses) {
-        responses.push_back(std::move(entry.response));
+    return completion_future.get();
+}
+
+inline void MethodRegistry::async_invoke_batch(const std::vector<Request>& requests,
+                                               std::function<void(std::vector<Response>)> handler,
+                                               const InvokeContext& context) {
+    if (requests.empty()) {
+        handler(std::vector<Response>());
+        return;
     }
 
-    return responses;
+    // 每个请求写入自己的槽位，无需加锁也无需排序；最后完成的任务负责收集并回调
+    struct BatchState {
+        BatchState(std::size_t count, std::function<void(std::vector<Response>)> done)
+            : slots(count)
+            , remaining(count)
+            , handler(std::move(done))
+        {}
+
+        std::vector<boost::optional<Response>> slots;
+        std::atomic<std::size_t> remaining;
+        std::function<void(std::vector<Response>)> handler;
+    };
+
+    auto state = std::make_shared<BatchState>(requests.size(), std::move(handler));
+    auto pool = get_batch_pool();
+
+    for (std::size_t idx = 0; idx < requests.size(); ++idx) {
+        const Request* request = &requests[idx];
+
+        auto task = [this, idx, request, state, context]() {
+            bool has_id = request->has_id();
+            // 异步方法可能在其他线程完成，槽位在完成回调中写入
+            begin_invoke(*request, [idx, has_id, state](Response response) {
+                if (has_id) {
+                    state->slots[idx] = std::move(response);
+                }
+
+                if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::vector<Response> responses;
+                    responses.reserve(state->slots.size());
+                    for (auto& slot : state->slots) {
+                        if (slot) {
+                            responses.push_back(std::move(*slot));
+                        }
+                    }
+                    state->handler(std::move(responses));
+                }
+            }, context);
+        };
+
+        if (pool) {
+            scheduler_.post(*pool, priority_of(*request, context), std::move(task));
+        } else {
+            // 已 shutdown()：begin_invoke() 直接以错误完成
+            task();
+        }
+    }
 }
 
 } // namespace detail
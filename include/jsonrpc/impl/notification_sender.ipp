@@ -0,0 +1,204 @@
+#pragma once
+
+#include <jsonrpc/detail/notification_sender.hpp>
+#include <jsonrpc/detail/framed_client_session.hpp>
+#include <boost/beast/http.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造与析构
+// ============================================================================
+
+inline NotificationSender::NotificationSender(const std::string& host,
+                                              const std::string& port,
+                                              std::chrono::milliseconds timeout,
+                                              std::function<void(const std::string&)> logger,
+                                              Transport transport,
+                                              std::size_t capacity,
+                                              NotifyOverflow policy,
+                                              std::shared_ptr<EndpointCache> endpoint_cache)
+    : host_(host)
+    , port_(port)
+    , timeout_(timeout)
+    , logger_(std::move(logger))
+    , transport_(transport)
+    , capacity_(capacity == 0 ? 1 : capacity)
+    , policy_(policy)
+    , endpoint_cache_(std::move(endpoint_cache))
+    , io_context_()
+    , resolver_(io_context_)
+    , stream_(io_context_)
+    , connected_(false)
+    , sending_(false)
+    , stopping_(false)
+    , dropped_(0)
+{
+}
+
+inline NotificationSender::~NotificationSender() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+
+    // 后台线程发送完剩余通知后退出
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    close();
+}
+
+inline void NotificationSender::log(const std::string& message) const {
+    if (logger_) {
+        logger_(message);
+    }
+}
+
+// ============================================================================
+// 入队
+// ============================================================================
+
+inline bool NotificationSender::push(std::string json) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= capacity_) {
+            if (policy_ == NotifyOverflow::Drop) {
+                ++dropped_;
+                return false;
+            }
+            not_full_.wait(lock, [this] { return queue_.size() < capacity_ || stopping_; });
+            if (stopping_) {
+                ++dropped_;
+                return false;
+            }
+        }
+
+        queue_.push_back(std::move(json));
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&NotificationSender::run, this);
+        }
+    }
+    not_empty_.notify_one();
+    return true;
+}
+
+inline void NotificationSender::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    drained_.wait(lock, [this] { return queue_.empty() && !sending_; });
+}
+
+inline std::size_t NotificationSender::dropped() const {
+    return dropped_.load();
+}
+
+// ============================================================================
+// 后台线程
+// ============================================================================
+
+inline void NotificationSender::run() {
+    std::vector<std::string> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            sending_ = false;
+            if (queue_.empty()) {
+                drained_.notify_all();
+            }
+            not_empty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+            if (queue_.empty()) {
+                return;  // 正在停止且已发送完
+            }
+
+            // 一次取走全部待发送的通知
+            batch.clear();
+            batch.reserve(queue_.size());
+            for (auto& json : queue_) {
+                batch.push_back(std::move(json));
+            }
+            queue_.clear();
+            sending_ = true;
+        }
+        not_full_.notify_all();
+
+        send(batch);
+    }
+}
+
+inline void NotificationSender::send(const std::vector<std::string>& batch) {
+    std::string wire;
+    for (const auto& json : batch) {
+        FramedClientSession::append_frame(transport_, host_, json, wire);
+    }
+
+    // 不重试：连接在写出后断开时无法确定服务端已处理了哪些通知
+    try {
+        write_batch(wire, batch.size());
+    } catch (const boost::system::system_error& e) {
+        close();
+        log(std::string("发送通知失败: ") + e.what());
+    }
+}
+
+inline void NotificationSender::write_batch(const std::string& wire, std::size_t count) {
+    // 两批之间连接上不应有待读数据，对端已关闭时直接重连，避免写入已失效的连接
+    if (connected_ && probe_socket(stream_.socket()) == SocketProbe::Closed) {
+        close();
+    }
+    connect();
+
+    stream_.expires_after(timeout_);
+    boost::asio::write(stream_, boost::asio::buffer(wire));
+
+    if (transport_ != Transport::Http) {
+        return;
+    }
+
+    // HTTP 流水线：服务端按顺序为每个通知回一个（通常为 204 的）响应
+    boost::beast::flat_buffer buffer;
+    bool keep_alive = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        boost::beast::http::response<boost::beast::http::string_body> response;
+        stream_.expires_after(timeout_);
+        boost::beast::http::read(stream_, buffer, response);
+        keep_alive = keep_alive && response.keep_alive();
+    }
+    if (!keep_alive) {
+        close();
+    }
+}
+
+inline void NotificationSender::connect() {
+    if (connected_) {
+        return;
+    }
+    auto const endpoints = resolve_endpoints(resolver_, host_, port_, endpoint_cache_);
+    stream_.expires_after(timeout_);
+    try {
+        stream_.connect(endpoints);
+    } catch (const boost::system::system_error&) {
+        if (endpoint_cache_) {
+            endpoint_cache_->invalidate(host_, port_);
+        }
+        throw;
+    }
+    connected_ = true;
+}
+
+inline void NotificationSender::close() {
+    if (!connected_) {
+        return;
+    }
+    connected_ = false;
+
+    boost::beast::error_code ec;
+    stream_.socket().shutdown(boost::asio::socket_base::shutdown_both, ec);
+    stream_.socket().close(ec);
+}
+
+} // namespace detail
+} // namespace jsonrpc
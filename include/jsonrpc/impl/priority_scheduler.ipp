@@ -0,0 +1,108 @@
+#pragma once
+
+#include <jsonrpc/detail/priority_scheduler.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace jsonrpc {
+namespace detail {
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+inline PriorityScheduler::PriorityScheduler() {
+    for (std::size_t i = 0; i < class_count; ++i) {
+        credits_[i] = 0;
+    }
+}
+
+inline void PriorityScheduler::set_policy(const SchedulingPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+    for (std::size_t i = 0; i < class_count; ++i) {
+        credits_[i] = 0;
+    }
+}
+
+inline std::size_t PriorityScheduler::queued(Priority priority) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queues_[static_cast<std::size_t>(priority)].size();
+}
+
+// ============================================================================
+// 入队与出队
+// ============================================================================
+
+inline void PriorityScheduler::post(boost::asio::thread_pool& pool, Priority priority, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[static_cast<std::size_t>(priority)].push_back(std::move(task));
+    }
+
+    // 每个占位任务恰好取出一个任务，取出哪个由运行时的队列状态决定
+    boost::asio::post(pool, [this]() {
+        Task task = next();
+        if (task) {
+            task();
+        }
+    });
+}
+
+inline void PriorityScheduler::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < class_count; ++i) {
+        queues_[i].clear();
+        credits_[i] = 0;
+    }
+}
+
+inline PriorityScheduler::Task PriorityScheduler::next() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::size_t chosen = class_count;
+    if (policy_.mode == PriorityScheduling::Strict) {
+        for (std::size_t i = 0; i < class_count; ++i) {
+            if (!queues_[i].empty()) {
+                chosen = i;
+                break;
+            }
+        }
+    } else {
+        // 平滑加权轮转：非空队列各加上自己的权重，取最大者并减去本轮总权重
+        const std::size_t weights[class_count] = {
+            std::max<std::size_t>(policy_.high_weight, 1),
+            std::max<std::size_t>(policy_.normal_weight, 1),
+            std::max<std::size_t>(policy_.low_weight, 1)
+        };
+        long long total = 0;
+        for (std::size_t i = 0; i < class_count; ++i) {
+            if (queues_[i].empty()) {
+                continue;
+            }
+            credits_[i] += static_cast<long long>(weights[i]);
+            total += static_cast<long long>(weights[i]);
+            if (chosen == class_count || credits_[i] > credits_[chosen]) {
+                chosen = i;
+            }
+        }
+        if (chosen != class_count) {
+            credits_[chosen] -= total;
+        }
+    }
+
+    if (chosen == class_count) {
+        return Task();
+    }
+    Task task = std::move(queues_[chosen].front());
+    queues_[chosen].pop_front();
+    if (queues_[chosen].empty()) {
+        // 队列排空后不保留欠账或盈余，下次重新开始轮转
+        credits_[chosen] = 0;
+    }
+    return task;
+}
+
+} // namespace detail
+} // namespace jsonrpc
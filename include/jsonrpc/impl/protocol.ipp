@@ -4,6 +4,7 @@
 #include <jsonrpc/types.hpp>
 #include <jsonrpc/errors.hpp>
 #include <boost/json.hpp>
+#include <string>
 
 namespace jsonrpc {
 namespace detail {
@@ -37,20 +38,27 @@ inline bool Protocol::is_batch_request(const boost::json::value& jv) {
 // 解析请求
 // ============================================================================
 
-inline std::vector<Request> Protocol::parse_request(const std::string& json_str) {
-    // 解析 JSON 字符串
-    boost::json::value jv;
+inline std::vector<Request> Protocol::parse_request(const std::string& json_str,
+                                                    boost::json::storage_ptr sp) {
+    return parse_requests(json_str, std::move(sp)).requests;
+}
+
+inline ParsedRequests Protocol::parse_requests(boost::json::string_view json_str,
+                                               boost::json::storage_ptr sp) {
+    // 解析 JSON 字符串（jv 与解析结果使用同一存储，赋值时直接移动）
+    boost::json::value jv(sp);
     try {
-        jv = boost::json::parse(json_str);
+        jv = boost::json::parse(json_str, sp);
     } catch (const std::exception& e) {
         throw Error(ErrorCode::ParseError,
             std::string("JSON 解析失败: ") + e.what());
     }
 
-    std::vector<Request> requests;
+    ParsedRequests parsed;
+    parsed.is_batch = is_batch_request(jv);
 
     // 检查是否为批量请求
-    if (is_batch_request(jv)) {
+    if (parsed.is_batch) {
         const auto& arr = jv.as_array();
 
         // 空的批量请求是无效的
@@ -58,48 +66,128 @@ inline std::vector<Request> Protocol::parse_request(const std::string& json_str)
             throw Error(ErrorCode::InvalidRequest, "批量请求不能为空");
         }
 
-        // 解析每个请求
-        requests.reserve(arr.size());
+        // 解析每个请求（Request::from_json 出错时抛出合适的错误）
+        parsed.requests.reserve(arr.size());
         for (const auto& elem : arr) {
-            try {
-                requests.push_back(Request::from_json(elem));
-            } catch (const Error&) {
-                // Request::from_json 已经抛出了合适的错误
-                throw;
-            }
+            parsed.requests.push_back(Request::from_json(elem));
         }
     } else {
         // 单个请求
-        try {
-            requests.push_back(Request::from_json(jv));
-        } catch (const Error&) {
-            throw;
-        }
+        parsed.requests.push_back(Request::from_json(jv));
     }
 
-    return requests;
+    return parsed;
 }
 
 // ============================================================================
 // 序列化响应
 // ============================================================================
 
-inline std::string Protocol::serialize_response(const Response& response) {
-    boost::json::object obj = response.to_json();
+inline std::string Protocol::serialize_response(const Response& response,
+                                                boost::json::storage_ptr sp) {
+    boost::json::object obj = response.to_json(std::move(sp));
     return boost::json::serialize(obj);
 }
 
-inline std::string Protocol::serialize_batch_response(const std::vector<Response>& responses) {
-    boost::json::array arr;
+inline std::string Protocol::serialize_batch_response(const std::vector<Response>& responses,
+                                                      boost::json::storage_ptr sp) {
+    boost::json::array arr(sp);
     arr.reserve(responses.size());
 
     for (const auto& response : responses) {
-        arr.push_back(response.to_json());
+        arr.push_back(response.to_json(sp));
     }
 
     return boost::json::serialize(arr);
 }
 
+// ============================================================================
+// 直接写入输出缓冲区
+// ============================================================================
+
+namespace protocol_detail {
+
+/// 每次 serializer::read() 写入的块大小；更短的标量直接序列化
+constexpr std::size_t serialize_chunk_size = 4096;
+
+inline void append_chunks(boost::json::serializer& sr, std::string& out) {
+    while (!sr.done()) {
+        // 只扩出本次写入的一块（保留的大容量不会被整段清零），写完截到实际长度
+        std::size_t offset = out.size();
+        out.resize(offset + serialize_chunk_size);
+        boost::json::string_view written = sr.read(&out[offset], serialize_chunk_size);
+        out.resize(offset + written.size());
+    }
+}
+
+inline void append_serialized(boost::json::serializer& sr, const boost::json::value& jv, std::string& out) {
+    // id、数字、短字符串等标量直接序列化追加，不经过分块缓冲
+    if (!jv.is_structured() && (!jv.is_string() || jv.get_string().size() < serialize_chunk_size)) {
+        out.append(boost::json::serialize(jv));
+        return;
+    }
+    sr.reset(&jv);
+    append_chunks(sr, out);
+}
+
+inline void append_serialized(boost::json::serializer& sr, boost::json::string_view text, std::string& out) {
+    if (text.size() < serialize_chunk_size) {
+        out.append(boost::json::serialize(text));
+        return;
+    }
+    sr.reset(text);
+    append_chunks(sr, out);
+}
+
+inline void write_response(boost::json::serializer& sr, const Response& response, std::string& out) {
+    out.append("{\"jsonrpc\":\"2.0\",");
+
+    if (response.is_error()) {
+        const Error& error = response.error();
+        out.append("\"error\":{\"code\":");
+        out.append(std::to_string(static_cast<int>(error.code())));
+        out.append(",\"message\":");
+        append_serialized(sr, boost::json::string_view(error.message()), out);
+        if (!error.data().is_null()) {
+            out.append(",\"data\":");
+            append_serialized(sr, error.data(), out);
+        }
+        out.push_back('}');
+    } else {
+        out.append("\"result\":");
+        append_serialized(sr, response.result(), out);
+    }
+
+    out.append(",\"id\":");
+    append_serialized(sr, response.id(), out);
+    out.push_back('}');
+}
+
+} // namespace protocol_detail
+
+inline void Protocol::append_json(const boost::json::value& jv, std::string& out) {
+    boost::json::serializer sr;
+    protocol_detail::append_serialized(sr, jv, out);
+}
+
+inline void Protocol::write_response(const Response& response, std::string& out) {
+    boost::json::serializer sr;
+    protocol_detail::write_response(sr, response, out);
+}
+
+inline void Protocol::write_batch_response(const std::vector<Response>& responses, std::string& out) {
+    // 所有元素共用一个 serializer，其内部栈只分配一次
+    boost::json::serializer sr;
+    out.push_back('[');
+    for (std::size_t i = 0; i < responses.size(); ++i) {
+        if (i != 0) {
+            out.push_back(',');
+        }
+        protocol_detail::write_response(sr, responses[i], out);
+    }
+    out.push_back(']');
+}
+
 // ============================================================================
 // 序列化请求（客户端用）
 // ============================================================================
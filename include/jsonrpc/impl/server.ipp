@@ -3,14 +3,87 @@
 #include <jsonrpc/server.hpp>
 #include <jsonrpc/detail/method_registry.hpp>
 #include <jsonrpc/detail/server_session.hpp>
+#include <jsonrpc/detail/framed_server_session.hpp>
 #include <boost/asio.hpp>
+#include <algorithm>
+#include <cstdio>
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <chrono>
 #include <string>
+#include <vector>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+#include <sys/stat.h>
+#endif
 
 namespace jsonrpc {
 
+namespace detail {
+
+/**
+ * @brief 将线程绑定到指定 CPU 核心（仅 Linux 生效）
+ *
+ * @param thread 目标线程
+ * @param index 逻辑序号，按 hardware_concurrency 取模
+ */
+inline void pin_thread_to_core(std::thread& thread, std::size_t index) {
+#if defined(__linux__)
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(index % cores), &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)index;
+#endif
+}
+
+#if defined(SO_REUSEPORT)
+typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+#endif
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+/**
+ * @brief 删除上次运行残留的 Unix 域套接字文件，否则 bind 会失败
+ *
+ * 只删除无人监听的套接字文件（连接被拒绝）；路径上是其他类型的文件或仍有服务器在监听时
+ * 与 TCP 地址被占用一样抛出异常，不会删除或接管。
+ *
+ * @param path 套接字文件路径
+ * @throws boost::system::system_error 路径已被占用
+ */
+inline void remove_stale_unix_socket(const std::string& path) {
+    struct stat info;
+    if (::lstat(path.c_str(), &info) != 0) {
+        return;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        throw boost::system::system_error(boost::asio::error::make_error_code(boost::asio::error::address_in_use),
+                                          "路径已存在且不是套接字: " + path);
+    }
+
+    boost::asio::io_context io_context;
+    boost::asio::local::stream_protocol::socket probe(io_context);
+    boost::system::error_code ec;
+    probe.connect(boost::asio::local::stream_protocol::endpoint(path), ec);
+    if (ec == boost::asio::error::connection_refused) {
+        std::remove(path.c_str());
+        return;
+    }
+    throw boost::system::system_error(ec ? ec : boost::asio::error::make_error_code(boost::asio::error::address_in_use),
+                                      "Unix 域套接字已被其他服务器使用: " + path);
+}
+#endif
+
+} // namespace detail
+
 // ============================================================================
 // Server::Impl 类（Pimpl 实现）
 // ============================================================================
@@ -26,6 +99,10 @@ public:
         : io_context_()
         , acceptor_(io_context_)
         , registry_(std::make_shared<detail::MethodRegistry>())
+        , io_threads_(1)
+        , per_core_(false)
+        , transport_(Transport::Http)
+        , active_workers_(0)
         , running_(false)
         , endpoint_(boost::asio::ip::tcp::endpoint(
             boost::asio::ip::make_address(address),
@@ -36,6 +113,34 @@ public:
         prepare_acceptor();
     }
 
+    ~Impl() {
+        // 不再接受新的调用，线程池回收后也不会重建
+        registry_->shutdown();
+
+        // 线程池中的调用完成后会向会话执行器投递回调，必须在 io_context 销毁前等待其结束
+        registry_->drain();
+
+        // 关闭所有连接：等待期间不会再读入新的请求，执行中的方法经 CallContext 得知连接已断开
+        close_sessions();
+
+        // 异步方法的 Responder 可能仍被定时器或其他线程持有，限时等待它们回复或销毁；
+        // 等待期间继续驱动本服务器的事件循环，挂在其上的定时器才能触发
+        auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (registry_->outstanding() != 0 && std::chrono::steady_clock::now() < give_up) {
+            std::size_t handled = io_context_.poll();
+            for (auto& loop : core_loops_) {
+                handled += loop->io_context.poll();
+            }
+            restart_contexts();
+            if (handled == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        // 超时仍未回复的调用：在 io_context 销毁前释放其响应回调，之后迟到的回复直接丢弃
+        registry_->abandon_outstanding();
+    }
+
     /**
      * @brief 获取 io_context
      */
@@ -72,6 +177,7 @@ public:
      * @brief 离开运行状态
      */
     void leave_running() {
+        registry_->set_read_only(false);
         running_.store(false);
     }
 
@@ -82,15 +188,105 @@ public:
         return running_.load();
     }
 
+    /**
+     * @brief 设置 I/O 线程数
+     */
+    void set_io_threads(std::size_t threads) {
+        threads = threads == 0 ? 1 : threads;
+        if (per_core_ && threads != io_threads_) {
+            // 每核 acceptor 数量随之变化，下次启动时重新打开
+            teardown_acceptor();
+        }
+        io_threads_ = threads;
+    }
+
+    std::size_t io_threads() const {
+        return io_threads_;
+    }
+
+    /**
+     * @brief 切换 thread-per-core 模式
+     */
+    void set_per_core_acceptors(bool enable) {
+#if !defined(SO_REUSEPORT)
+        if (enable) {
+            throw std::logic_error("当前平台不支持 SO_REUSEPORT，无法启用每核 acceptor");
+        }
+#endif
+        if (enable != per_core_) {
+            // 已绑定的 acceptor 需要按新模式重新打开（SO_REUSEPORT 必须在 bind 前设置）
+            teardown_acceptor();
+            per_core_ = enable;
+        }
+    }
+
+    bool per_core_acceptors() const {
+        return per_core_;
+    }
+
+    void set_single_request_dispatch(SingleRequestDispatch mode) {
+        session_options_.inline_single_requests = (mode == SingleRequestDispatch::Inline);
+    }
+
+    SingleRequestDispatch single_request_dispatch() const {
+        return session_options_.inline_single_requests
+            ? SingleRequestDispatch::Inline
+            : SingleRequestDispatch::Pooled;
+    }
+
+    void set_transport(Transport transport) {
+        transport_ = transport;
+    }
+
+    /**
+     * @brief 增加一个 Unix 域套接字监听路径
+     */
+    void add_unix_listener(const std::string& path) {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        // 已打开的 acceptor 在下次启动时连同新路径一起重新打开
+        teardown_acceptor();
+        std::unique_ptr<UnixListener> listener(new UnixListener(io_context_, path));
+        unix_listeners_.push_back(std::move(listener));
+#else
+        (void)path;
+        throw std::logic_error("当前平台不支持 Unix 域套接字");
+#endif
+    }
+
+    Transport transport() const {
+        return transport_;
+    }
+
+    /**
+     * @brief 打开监听并开始接受连接
+     *
+     * thread-per-core 模式下方法表在运行期间保持只读。
+     */
+    void begin_serving() {
+        prepare_acceptor();
+        if (per_core_) {
+            registry_->set_read_only(true);
+        }
+        do_accept();
+    }
+
     /**
      * @brief 开始异步接受连接
+     *
+     * 共享线程池模式下每个新连接绑定到独立的 strand，多个 I/O 线程同时运行
+     * io_context_ 时，同一会话的回调仍然串行执行；thread-per-core 模式下
+     * 每个 acceptor 只由一个线程驱动，无需 strand。
      */
     void do_accept() {
-        acceptor_.async_accept(
-            [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
-                on_accept(ec, std::move(socket));
-            }
-        );
+        start_accept(acceptor_, io_context_);
+        for (auto& loop : core_loops_) {
+            start_accept(loop->acceptor, loop->io_context);
+        }
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        for (auto& listener : unix_listeners_) {
+            start_accept(listener->acceptor, io_context_);
+        }
+#endif
     }
 
     /**
@@ -101,17 +297,53 @@ public:
             throw std::logic_error("Server is already running");
         }
 
-        prepare_acceptor();
+        try {
+            begin_serving();
+        } catch (...) {
+            leave_running();
+            throw;
+        }
 
-        // 开始接受连接
-        do_accept();
+        // 创建 I/O 线程：共享模式下全部运行 io_context_，每核模式下各自运行独立的 io_context
+        active_workers_.store(io_threads_);
+        for (std::size_t i = 0; i < io_threads_; ++i) {
+            boost::asio::io_context& io_context = loop_context(i);
+            worker_threads_.emplace_back([this, &io_context]() {
+                io_context.run();
+                // 最后一个退出的线程负责复位运行状态
+                if (active_workers_.fetch_sub(1) == 1) {
+                    leave_running();
+                }
+            });
+            if (per_core_) {
+                detail::pin_thread_to_core(worker_threads_.back(), i);
+            }
+        }
+    }
 
-        // 创建工作线程
-        worker_thread_.reset(new std::thread([this]() {
-            io_context_.run();
-            io_context_.restart();
-            leave_running();
-        }));
+    /**
+     * @brief 在当前线程阻塞运行（额外启动 io_threads_ - 1 个线程）
+     */
+    void run_blocking() {
+        std::vector<std::thread> extra_threads;
+        for (std::size_t i = 1; i < io_threads_; ++i) {
+            boost::asio::io_context& io_context = loop_context(i);
+            extra_threads.emplace_back([&io_context]() {
+                io_context.run();
+            });
+            if (per_core_) {
+                detail::pin_thread_to_core(extra_threads.back(), i);
+            }
+        }
+
+        io_context_.run();
+
+        for (auto& thread : extra_threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        restart_contexts();
     }
 
     /**
@@ -126,15 +358,21 @@ public:
         // 关闭 acceptor（停止接受新连接）
         teardown_acceptor();
 
-        // 停止 io_context
+        // 停止所有 io_context
         io_context_.stop();
+        for (auto& loop : core_loops_) {
+            loop->io_context.stop();
+        }
 
-        // 等待工作线程结束
-        if (worker_thread_ && worker_thread_->joinable()) {
-            worker_thread_->join();
+        // 等待所有 I/O 线程结束
+        for (auto& thread : worker_threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
         }
-        worker_thread_.reset();
-        io_context_.restart();
+        worker_threads_.clear();
+        restart_contexts();
+        registry_->set_read_only(false);
     }
 
     void prepare_acceptor() {
@@ -142,10 +380,29 @@ public:
             return;
         }
 
-        acceptor_.open(endpoint_.protocol());
-        acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
-        acceptor_.bind(endpoint_);
-        acceptor_.listen();
+        // 每核模式：loop 0 复用 io_context_/acceptor_，其余核心各自拥有事件循环
+        std::size_t extra_loops = per_core_ ? io_threads_ - 1 : 0;
+        if (core_loops_.size() != extra_loops) {
+            core_loops_.clear();
+            for (std::size_t i = 0; i < extra_loops; ++i) {
+                core_loops_.emplace_back(new CoreLoop());
+            }
+        }
+
+        try {
+            open_acceptor(acceptor_);
+            for (auto& loop : core_loops_) {
+                open_acceptor(loop->acceptor);
+            }
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+            for (auto& listener : unix_listeners_) {
+                open_unix_acceptor(*listener);
+            }
+#endif
+        } catch (...) {
+            close_acceptors();
+            throw;
+        }
         acceptor_ready_ = true;
     }
 
@@ -153,18 +410,171 @@ public:
         if (!acceptor_ready_) {
             return;
         }
-        boost::system::error_code ec;
-        acceptor_.close(ec);
+        close_acceptors();
         acceptor_ready_ = false;
     }
 
 private:
+    /**
+     * @brief thread-per-core 模式下的独立事件循环
+     *
+     * 每个核心拥有自己的 io_context 和 acceptor（SO_REUSEPORT），
+     * 连接及其缓冲区只在所属线程上访问。
+     */
+    struct CoreLoop {
+        CoreLoop()
+            : io_context(1)
+            , acceptor(io_context)
+        {}
+
+        boost::asio::io_context io_context;
+        boost::asio::ip::tcp::acceptor acceptor;
+    };
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    /**
+     * @brief Unix 域套接字监听
+     *
+     * 与 TCP acceptor 共用 io_context_（每核模式下为第 0 个核心）和方法注册表。
+     */
+    struct UnixListener {
+        UnixListener(boost::asio::io_context& io_context, const std::string& socket_path)
+            : path(socket_path)
+            , acceptor(io_context)
+        {}
+
+        std::string path;
+        boost::asio::local::stream_protocol::acceptor acceptor;
+    };
+
+    void open_unix_acceptor(UnixListener& listener) {
+        detail::remove_stale_unix_socket(listener.path);
+
+        boost::asio::local::stream_protocol::endpoint endpoint(listener.path);
+        listener.acceptor.open(endpoint.protocol());
+        try {
+            listener.acceptor.bind(endpoint);
+            listener.acceptor.listen();
+        } catch (...) {
+            // 路径上的文件不是本服务器创建的，close_acceptors() 不能删除它
+            boost::system::error_code ignored;
+            listener.acceptor.close(ignored);
+            throw;
+        }
+    }
+#endif
+
+    /**
+     * @brief 获取第 index 个 I/O 线程应运行的 io_context
+     */
+    boost::asio::io_context& loop_context(std::size_t index) {
+        if (!per_core_ || index == 0 || index > core_loops_.size()) {
+            return io_context_;
+        }
+        return core_loops_[index - 1]->io_context;
+    }
+
+    void open_acceptor(boost::asio::ip::tcp::acceptor& acceptor) {
+        acceptor.open(endpoint_.protocol());
+        acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#if defined(SO_REUSEPORT)
+        if (per_core_) {
+            acceptor.set_option(detail::reuse_port(true));
+        }
+#endif
+        acceptor.bind(endpoint_);
+        acceptor.listen();
+    }
+
+    void close_acceptors() {
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+        for (auto& loop : core_loops_) {
+            loop->acceptor.close(ec);
+        }
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        for (auto& listener : unix_listeners_) {
+            if (listener->acceptor.is_open()) {
+                listener->acceptor.close(ec);
+                std::remove(listener->path.c_str());
+            }
+        }
+#endif
+    }
+
+    void restart_contexts() {
+        io_context_.restart();
+        for (auto& loop : core_loops_) {
+            loop->io_context.restart();
+        }
+    }
+
+    /**
+     * @brief 在指定 acceptor（TCP 或 Unix 域套接字）上发起一次异步 accept
+     */
+    template<typename Acceptor>
+    void start_accept(Acceptor& acceptor, boost::asio::io_context& io_context) {
+        boost::asio::any_io_executor executor = per_core_
+            ? boost::asio::any_io_executor(io_context.get_executor())
+            : boost::asio::any_io_executor(boost::asio::make_strand(io_context));
+
+        acceptor.async_accept(
+            executor,
+            [this, &acceptor, &io_context](boost::system::error_code ec,
+                                           typename Acceptor::protocol_type::socket socket) {
+                // 会话只依赖流式读写，统一转换为与地址族无关的套接字
+                on_accept(ec, detail::stream_socket(std::move(socket)), acceptor, io_context);
+            }
+        );
+    }
+
+    /**
+     * @brief 记录新会话，服务器析构时关闭
+     *
+     * 长度每到 2 的幂（不小于 64）时清理已结束的会话，摊还开销为常数。
+     */
+    template<typename Session>
+    void track_session(std::vector<std::weak_ptr<Session>>& sessions, const std::shared_ptr<Session>& session) {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        std::size_t size = sessions.size();
+        if (size >= 64 && (size & (size - 1)) == 0) {
+            sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+                [](const std::weak_ptr<Session>& entry) { return entry.expired(); }), sessions.end());
+        }
+        sessions.push_back(session);
+    }
+
+    /**
+     * @brief 关闭所有仍存活的会话（调用时没有 I/O 线程在运行）
+     */
+    void close_sessions() {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        for (auto& entry : http_sessions_) {
+            if (auto session = entry.lock()) {
+                session->close();
+            }
+        }
+        for (auto& entry : framed_sessions_) {
+            if (auto session = entry.lock()) {
+                session->close();
+            }
+        }
+        http_sessions_.clear();
+        framed_sessions_.clear();
+    }
+
     /**
      * @brief 接受连接完成回调
      * @param ec 错误码
      * @param socket 新连接的 socket
+     * @param acceptor 产生该连接的 acceptor
+     * @param io_context acceptor 所属的 io_context
      */
-    void on_accept(boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
+    template<typename Acceptor>
+    void on_accept(boost::system::error_code ec,
+                   detail::stream_socket socket,
+                   Acceptor& acceptor,
+                   boost::asio::io_context& io_context) {
         if (ec) {
             // 如果是 operation_aborted，说明 acceptor 已关闭
             if (ec == boost::asio::error::operation_aborted) {
@@ -173,26 +583,53 @@ private:
             // 其他错误记录并继续
             log(std::string("接受连接失败: ") + ec.message());
         } else {
-            // 创建会话并启动
-            std::make_shared<detail::ServerSession>(
-                std::move(socket),
-                registry_,
-                logger_
-            )->start();
+            // 按传输方式创建会话并启动
+            if (transport_ == Transport::Http) {
+                auto session = std::make_shared<detail::ServerSession>(
+                    std::move(socket),
+                    registry_,
+                    logger_,
+                    session_options_
+                );
+                track_session(http_sessions_, session);
+                session->start();
+            } else {
+                auto session = std::make_shared<detail::FramedServerSession>(
+                    std::move(socket),
+                    registry_,
+                    logger_,
+                    session_options_,
+                    transport_
+                );
+                track_session(framed_sessions_, session);
+                session->start();
+            }
         }
 
         // 继续接受下一个连接
-        do_accept();
+        start_accept(acceptor, io_context);
     }
 
-    boost::asio::io_context io_context_;                        ///< I/O 上下文
+    boost::asio::io_context io_context_;                        ///< I/O 上下文（每核模式下为 loop 0）
     boost::asio::ip::tcp::acceptor acceptor_;                   ///< TCP 接受器
+    std::vector<std::unique_ptr<CoreLoop>> core_loops_;         ///< 每核模式下的其余事件循环
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    std::vector<std::unique_ptr<UnixListener>> unix_listeners_; ///< Unix 域套接字监听
+#endif
     std::shared_ptr<detail::MethodRegistry> registry_;          ///< 方法注册表
-    std::unique_ptr<std::thread> worker_thread_;                ///< 工作线程
+    std::vector<std::thread> worker_threads_;                   ///< I/O 线程（start() 启动）
+    std::size_t io_threads_;                                    ///< I/O 线程数
+    bool per_core_;                                             ///< 是否启用 thread-per-core 模式
+    Transport transport_;                                       ///< 传输方式
+    std::atomic<std::size_t> active_workers_;                   ///< 仍在运行的 I/O 线程数
     std::atomic<bool> running_;                                 ///< 运行状态标志
     boost::asio::ip::tcp::endpoint endpoint_;                   ///< 监听地址
     bool acceptor_ready_;                                       ///< acceptor 状态
     std::function<void(const std::string&)> logger_;            ///< 日志回调
+    detail::SessionOptions session_options_;                    ///< 新会话使用的配置
+    std::mutex sessions_mutex_;                                 ///< 保护会话列表（每核模式下多个线程同时接受连接）
+    std::vector<std::weak_ptr<detail::ServerSession>> http_sessions_;        ///< HTTP 会话（析构时关闭）
+    std::vector<std::weak_ptr<detail::FramedServerSession>> framed_sessions_;  ///< 原始 TCP 会话（析构时关闭）
 };
 
 // ============================================================================
@@ -226,6 +663,11 @@ void Server::register_method(const std::string& name, Func&& func) {
     impl_->get_registry()->register_method(name, std::forward<Func>(func));
 }
 
+template<typename Func>
+void Server::register_async_method(const std::string& name, Func&& func) {
+    impl_->get_registry()->register_async_method(name, std::forward<Func>(func));
+}
+
 // ============================================================================
 // 运行服务器（阻塞）
 // ============================================================================
@@ -246,13 +688,11 @@ inline void Server::run() {
         Server::Impl* impl_;
     } guard(impl_.get());
 
-    impl_->prepare_acceptor();
-    // 开始接受连接
-    impl_->do_accept();
+    // 打开监听并开始接受连接
+    impl_->begin_serving();
 
-    // 阻塞运行 I/O 上下文
-    impl_->get_io_context().run();
-    impl_->get_io_context().restart();
+    // 阻塞运行 I/O 上下文（多线程模式下当前线程也参与）
+    impl_->run_blocking();
 }
 
 // ============================================================================
@@ -292,6 +732,68 @@ inline void Server::set_batch_concurrency(std::size_t threads) {
     impl_->get_registry()->set_batch_concurrency(threads);
 }
 
+inline void Server::set_method_priority(const std::string& name, Priority priority) {
+    impl_->get_registry()->set_method_priority(name, priority);
+}
+
+inline void Server::set_priority_scheduling(const SchedulingPolicy& policy) {
+    if (is_running()) {
+        throw std::logic_error("服务器正在运行时无法调整优先级调度策略，请先 stop()");
+    }
+    impl_->get_registry()->set_priority_scheduling(policy);
+}
+
+inline void Server::set_io_threads(std::size_t threads) {
+    if (is_running()) {
+        throw std::logic_error("服务器正在运行时无法调整 I/O 线程数，请先 stop()");
+    }
+    impl_->set_io_threads(threads);
+}
+
+inline std::size_t Server::io_threads() const {
+    return impl_->io_threads();
+}
+
+inline void Server::set_per_core_acceptors(bool enable) {
+    if (is_running()) {
+        throw std::logic_error("服务器正在运行时无法切换 thread-per-core 模式，请先 stop()");
+    }
+    impl_->set_per_core_acceptors(enable);
+}
+
+inline bool Server::per_core_acceptors() const {
+    return impl_->per_core_acceptors();
+}
+
+inline void Server::set_single_request_dispatch(SingleRequestDispatch mode) {
+    if (is_running()) {
+        throw std::logic_error("服务器正在运行时无法调整单请求调度方式，请先 stop()");
+    }
+    impl_->set_single_request_dispatch(mode);
+}
+
+inline SingleRequestDispatch Server::single_request_dispatch() const {
+    return impl_->single_request_dispatch();
+}
+
+inline void Server::set_transport(Transport transport) {
+    if (is_running()) {
+        throw std::logic_error("服务器正在运行时无法切换传输方式，请先 stop()");
+    }
+    impl_->set_transport(transport);
+}
+
+inline Transport Server::transport() const {
+    return impl_->transport();
+}
+
+inline void Server::listen_unix(const std::string& path) {
+    if (is_running()) {
+        throw std::logic_error("服务器正在运行时无法增加监听，请先 stop()");
+    }
+    impl_->add_unix_listener(path);
+}
+
 inline void Server::set_logger(std::function<void(const std::string&)> logger) {
     impl_->set_logger(std::move(logger));
 }
@@ -3,6 +3,7 @@
 #include <jsonrpc/detail/server_session.hpp>
 #include <jsonrpc/detail/protocol.hpp>
 #include <jsonrpc/errors.hpp>
+#include <cstdlib>
 
 namespace jsonrpc {
 namespace detail {
@@ -12,12 +13,16 @@ namespace detail {
 // ============================================================================
 
 inline ServerSession::ServerSession(
-    boost::asio::ip::tcp::socket socket,
+    stream_socket socket,
     std::shared_ptr<MethodRegistry> registry,
-    std::function<void(const std::string&)> logger)
+    std::function<void(const std::string&)> logger,
+    SessionOptions options)
     : stream_(std::move(socket))
     , registry_(std::move(registry))
     , logger_(std::move(logger))
+    , options_(options)
+    , is_batch_(false)
+    , disconnected_(std::make_shared<std::atomic<bool>>(false))
 {
 }
 
@@ -35,6 +40,10 @@ inline void ServerSession::start() {
     do_read();
 }
 
+inline void ServerSession::close() {
+    stream_.close();
+}
+
 // ============================================================================
 // 异步读取 HTTP 请求
 // ============================================================================
@@ -88,12 +97,7 @@ inline void ServerSession::process_request() {
     // 验证 HTTP 方法（必须是 POST）
     if (req_.method() != boost::beast::http::verb::post) {
         log("收到非 POST 请求");
-        res_ = {};
-        res_.result(boost::beast::http::status::method_not_allowed);
-        res_.set(boost::beast::http::field::content_type, "text/plain");
-        res_.body() = "仅支持 POST 方法";
-        res_.prepare_payload();
-        do_write();
+        write_http_error(boost::beast::http::status::method_not_allowed, "仅支持 POST 方法");
         return;
     }
 
@@ -101,57 +105,155 @@ inline void ServerSession::process_request() {
     auto content_type = req_[boost::beast::http::field::content_type];
     if (content_type.find("application/json") == std::string::npos) {
         log("Content-Type 无效: " + std::string(content_type));
-        res_ = {};
-        res_.result(boost::beast::http::status::unsupported_media_type);
-        res_.set(boost::beast::http::field::content_type, "text/plain");
-        res_.body() = "Content-Type 必须是 application/json";
-        res_.prepare_payload();
-        do_write();
+        write_http_error(boost::beast::http::status::unsupported_media_type, "Content-Type 必须是 application/json");
         return;
     }
 
-    // 提取请求 body
-    std::string request_body = req_.body();
-
-    // 解析 JSON-RPC 请求
-    std::vector<Request> requests;
-    bool is_batch = false;
+    // 解析 JSON-RPC 请求（直接读取请求体，只解析一次）
     try {
-        requests = Protocol::parse_request(request_body);
-        is_batch = (requests.size() > 1) || Protocol::is_batch_request(boost::json::parse(request_body));
+        ParsedRequests parsed = Protocol::parse_requests(req_.body(), arena_.storage());
+        requests_ = std::move(parsed.requests);
+        is_batch_ = parsed.is_batch;
     } catch (const Error& e) {
         // 解析错误，返回错误响应
         log(std::string("解析请求失败: ") + e.what());
         Response error_response(e, boost::json::value(nullptr));
-        res_ = {};
+        reset_response();
         res_.result(boost::beast::http::status::ok);
         res_.set(boost::beast::http::field::content_type, "application/json");
-        res_.body() = Protocol::serialize_response(error_response);
+        Protocol::write_response(error_response, res_.body());
         res_.prepare_payload();
         do_write();
         return;
     }
 
-    // 调用方法
-    std::vector<Response> responses = registry_->invoke_batch(requests);
+    // 调用方告知的剩余等待时间，排队超过它的请求不再执行
+    std::chrono::milliseconds timeout(0);
+    auto timeout_field = req_[timeout_header];
+    if (!timeout_field.empty()) {
+        long long millis = std::strtoll(std::string(timeout_field).c_str(), nullptr, 10);
+        if (millis > 0) {
+            timeout = std::chrono::milliseconds(millis);
+        }
+    }
 
-    // 构造 HTTP 响应
-    res_ = {};
+    auto self = shared_from_this();
+    InvokeContext context;
+    context.executor = stream_.get_executor();
+    context.call = CallContext(timeout.count() > 0 ? CallContext::clock::now() + timeout
+                                                   : CallContext::clock::time_point::max(),
+                               disconnected_);
+
+    // 调用方指定的优先级覆盖方法的默认优先级，无法识别的值忽略
+    auto priority_field = req_[priority_header];
+    if (priority_field == "high") {
+        context.priority = Priority::High;
+    } else if (priority_field == "normal") {
+        context.priority = Priority::Normal;
+    } else if (priority_field == "low") {
+        context.priority = Priority::Low;
+    }
+
+    // 先开始监视连接再分派：内联执行的方法完成时能取消这次监视
+    watch_peer();
+
+    // 单个请求快速路径：不经过批量槽位收集
+    if (!is_batch_ && requests_.size() == 1) {
+        const Request& request = requests_.front();
+        bool has_id = request.has_id();
+
+        // 异步方法可能在任意线程回复；已在会话执行器上（内联执行的同步方法）时直接继续
+        std::function<void(Response)> on_response = [self, has_id](Response response) {
+            if (has_id) {
+                self->responses_.push_back(std::move(response));
+            }
+            boost::asio::dispatch(self->stream_.get_executor(), [self]() {
+                self->on_dispatch_complete();
+            });
+        };
+
+        if (options_.inline_single_requests) {
+            // 直接在 I/O 线程执行
+            registry_->begin_invoke(request, std::move(on_response), context);
+        } else {
+            // 一次线程池投递
+            registry_->async_invoke(request, std::move(on_response), context);
+        }
+        return;
+    }
+
+    // 交给线程池执行，完成后投递回本会话的执行器（strand），I/O 线程不等待
+    registry_->async_invoke_batch(requests_, [self](std::vector<Response> responses) {
+        self->responses_ = std::move(responses);
+        boost::asio::post(self->stream_.get_executor(), [self]() {
+            self->on_dispatch_complete();
+        });
+    }, context);
+}
+
+// ============================================================================
+// 执行期间监视连接
+// ============================================================================
+
+inline void ServerSession::watch_peer() {
+    auto self = shared_from_this();
+    stream_.socket().async_wait(stream_socket::wait_read, [self](boost::system::error_code ec) {
+        self->on_peer_event(ec);
+    });
+}
+
+inline void ServerSession::on_peer_event(boost::system::error_code ec) {
+    // 调用已完成，监视被取消
+    if (ec == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    // 可读且有数据是客户端流水线发来的下一个请求，本次不再监视；0 字节或出错即对端已关闭。
+    // 读到 FIN 时无法区分完全关闭与半关闭（shutdown 写方向），两者都按客户端放弃等待处理
+    if (ec || probe_socket(stream_.socket()) == SocketProbe::Closed) {
+        log("客户端已断开，取消未完成的请求");
+        disconnected_->store(true, std::memory_order_release);
+    }
+}
+
+// ============================================================================
+// 方法调用完成
+// ============================================================================
+
+inline void ServerSession::on_dispatch_complete() {
+    // 停止监视连接（写回与下一次读取会自行发现连接状态）
+    boost::system::error_code ignored;
+    stream_.socket().cancel(ignored);
+
+    // 请求中的 JSON 值位于 arena_，须在 on_write() 重置之前销毁
+    requests_.clear();
+
+    if (disconnected_->load(std::memory_order_acquire)) {
+        // 结果已无人读取，不再写回
+        responses_.clear();
+        arena_.reset();
+        stream_.socket().close(ignored);
+        return;
+    }
+
+    // 构造 HTTP 响应，JSON 直接序列化进响应体
+    reset_response();
     res_.result(boost::beast::http::status::ok);
     res_.set(boost::beast::http::field::content_type, "application/json");
 
-    if (is_batch) {
+    if (is_batch_) {
         // 批量响应
-        res_.body() = Protocol::serialize_batch_response(responses);
+        Protocol::write_batch_response(responses_, res_.body());
     } else {
         // 单个响应
-        if (!responses.empty()) {
-            res_.body() = Protocol::serialize_response(responses[0]);
+        if (!responses_.empty()) {
+            Protocol::write_response(responses_[0], res_.body());
         } else {
             // 通知类型的请求，无响应（返回 204 No Content）
             res_.result(boost::beast::http::status::no_content);
         }
     }
+    responses_.clear();
 
     res_.prepare_payload();
 
@@ -161,6 +263,27 @@ inline void ServerSession::process_request() {
     do_write();
 }
 
+inline void ServerSession::reset_response() {
+    // 保留上一次响应体的容量，超过上限时释放，避免长连接长期占用大块内存
+    std::string body = std::move(res_.body());
+    body.clear();
+    if (body.capacity() > max_retained_body_capacity) {
+        std::string().swap(body);
+    }
+
+    res_ = {};
+    res_.body() = std::move(body);
+}
+
+inline void ServerSession::write_http_error(boost::beast::http::status status, const std::string& message) {
+    reset_response();
+    res_.result(status);
+    res_.set(boost::beast::http::field::content_type, "text/plain");
+    res_.body().append(message);
+    res_.prepare_payload();
+    do_write();
+}
+
 // ============================================================================
 // 异步写入 HTTP 响应
 // ============================================================================
@@ -183,6 +306,9 @@ inline void ServerSession::do_write() {
 // ============================================================================
 
 inline void ServerSession::on_write(boost::beast::error_code ec, std::size_t /*bytes_transferred*/, bool close) {
+    // 本次请求的 JSON 分配一次性归还
+    arena_.reset();
+
     if (ec) {
         // 写入错误，关闭连接
         log(std::string("写入响应失败: ") + ec.message());
@@ -205,7 +331,7 @@ inline void ServerSession::on_write(boost::beast::error_code ec, std::size_t /*b
 
 inline void ServerSession::do_close() {
     boost::beast::error_code ec;
-    stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ec);
+    stream_.socket().shutdown(boost::asio::socket_base::shutdown_send, ec);
     // 忽略错误
 }
 
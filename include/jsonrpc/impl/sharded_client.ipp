@@ -0,0 +1,207 @@
+#pragma once
+
+#include <jsonrpc/sharded_client.hpp>
+#include <jsonrpc/detail/type_converter.hpp>
+#include <future>
+#include <stdexcept>
+
+namespace jsonrpc {
+
+// ============================================================================
+// 构造与配置
+// ============================================================================
+
+inline ShardedClient::ShardedClient(const std::vector<Endpoint>& shards, std::size_t virtual_nodes)
+    : ring_(virtual_nodes)
+{
+    if (shards.empty()) {
+        throw std::invalid_argument("分片客户端至少需要一个分片");
+    }
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        shards_.emplace_back(new Client(shards[i].host, shards[i].port));
+        // 分散调用需要各分片的异步调用同时推进
+        shards_.back()->set_io_threads(1);
+        ring_.add(shards[i].host + ":" + std::to_string(shards[i].port), i);
+    }
+}
+
+inline ShardedClient::~ShardedClient() {
+}
+
+inline ShardedClient::KeyExtractor ShardedClient::positional_key(std::size_t index) {
+    return [index](const boost::json::array& params) -> std::string {
+        if (index >= params.size()) {
+            throw std::invalid_argument("参数个数不足，无法取得第 " + std::to_string(index) + " 个参数作为分片键");
+        }
+        return key_of(params[index]);
+    };
+}
+
+inline void ShardedClient::set_key_extractor(const std::string& method, KeyExtractor extractor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    extractors_[method] = std::move(extractor);
+}
+
+inline std::size_t ShardedClient::shard_count() const {
+    return shards_.size();
+}
+
+inline std::size_t ShardedClient::shard_for(const std::string& key) const {
+    return ring_.locate(key);
+}
+
+inline Client& ShardedClient::shard(std::size_t index) {
+    return *shards_.at(index);
+}
+
+// ============================================================================
+// 路由
+// ============================================================================
+
+inline std::string ShardedClient::key_of(const boost::json::value& value) {
+    if (value.is_string()) {
+        const boost::json::string& text = value.as_string();
+        return std::string(text.data(), text.size());
+    }
+    return boost::json::serialize(value);
+}
+
+inline std::string ShardedClient::extract_key(const std::string& method, const boost::json::array& params) const {
+    KeyExtractor extractor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = extractors_.find(method);
+        if (it != extractors_.end()) {
+            extractor = it->second;
+        }
+    }
+    if (!extractor) {
+        return positional_key(0)(params);
+    }
+    return extractor(params);
+}
+
+inline Response ShardedClient::route(const std::string& method, boost::json::array params) {
+    Client& client = *shards_[shard_for(extract_key(method, params))];
+    return client.call_params(method, std::move(params));
+}
+
+inline void ShardedClient::route_notify(const std::string& method, boost::json::array params) {
+    Client& client = *shards_[shard_for(extract_key(method, params))];
+    client.notify_params(method, std::move(params));
+}
+
+// ============================================================================
+// 分散与合并
+// ============================================================================
+
+inline std::vector<boost::json::value> ShardedClient::gather(const std::string& method,
+                                                             std::vector<boost::json::array>& subsets)
+{
+    std::vector<std::future<Response>> futures(subsets.size());
+    for (std::size_t i = 0; i < subsets.size(); ++i) {
+        if (subsets[i].empty()) {
+            continue;
+        }
+        boost::json::array params;
+        params.push_back(std::move(subsets[i]));
+
+        auto promise = std::make_shared<std::promise<Response>>();
+        futures[i] = promise->get_future();
+        shards_[i]->async_call_params(method, std::move(params),
+            [promise](const Response& response) {
+                promise->set_value(response);
+            });
+    }
+
+    // 等待全部分片完成后再报告第一个错误，避免回调晚于本函数返回
+    std::vector<boost::json::value> results(subsets.size());
+    std::unique_ptr<Error> failure;
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        if (!futures[i].valid()) {
+            continue;
+        }
+        Response response = futures[i].get();
+        if (response.is_error()) {
+            if (!failure) {
+                failure.reset(new Error(response.error()));
+            }
+            continue;
+        }
+        results[i] = response.result();
+    }
+    if (failure) {
+        throw *failure;
+    }
+    return results;
+}
+
+// ============================================================================
+// 模板函数实现
+// ============================================================================
+
+template<typename Result, typename... Args>
+Result ShardedClient::call(const std::string& method, Args&&... args) {
+    boost::json::array params;
+    int dummy[] = {0, (
+        params.push_back(detail::json_converter<typename std::decay<Args>::type>::to_json(
+            std::forward<Args>(args)
+        )), 0)...};
+    (void)dummy;
+
+    Response response = route(method, std::move(params));
+    if (response.is_error()) {
+        throw response.error();
+    }
+    return detail::json_converter<Result>::from_json(response.result());
+}
+
+template<typename... Args>
+void ShardedClient::notify(const std::string& method, Args&&... args) {
+    boost::json::array params;
+    int dummy[] = {0, (
+        params.push_back(detail::json_converter<typename std::decay<Args>::type>::to_json(
+            std::forward<Args>(args)
+        )), 0)...};
+    (void)dummy;
+
+    route_notify(method, std::move(params));
+}
+
+template<typename Value, typename Key>
+std::vector<Value> ShardedClient::scatter_gather(const std::string& method, const std::vector<Key>& keys) {
+    // 按分片分组，记录每个键在原顺序中的位置
+    std::vector<boost::json::array> subsets(shards_.size());
+    std::vector<std::vector<std::size_t>> positions(shards_.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        boost::json::value key = detail::json_converter<Key>::to_json(keys[i]);
+        std::size_t shard = shard_for(key_of(key));
+        subsets[shard].push_back(std::move(key));
+        positions[shard].push_back(i);
+    }
+
+    std::vector<boost::json::value> results = gather(method, subsets);
+
+    std::vector<const boost::json::value*> slots(keys.size(), nullptr);
+    for (std::size_t shard = 0; shard < results.size(); ++shard) {
+        if (positions[shard].empty()) {
+            continue;
+        }
+        const boost::json::array* values = results[shard].if_array();
+        if (!values || values->size() != positions[shard].size()) {
+            throw Error(ErrorCode::InternalError, "分片 " + std::to_string(shard) + " 返回的结果数组与键数不符");
+        }
+        for (std::size_t n = 0; n < values->size(); ++n) {
+            slots[positions[shard][n]] = &(*values)[n];
+        }
+    }
+
+    std::vector<Value> merged;
+    merged.reserve(keys.size());
+    for (const boost::json::value* slot : slots) {
+        merged.push_back(detail::json_converter<Value>::from_json(*slot));
+    }
+    return merged;
+}
+
+} // namespace jsonrpc
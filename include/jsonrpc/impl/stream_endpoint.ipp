@@ -0,0 +1,99 @@
+#pragma once
+
+#include <jsonrpc/detail/stream_endpoint.hpp>
+
+namespace jsonrpc {
+namespace detail {
+
+inline bool is_unix_endpoint(const std::string& host) {
+    return host.compare(0, 5, "unix:") == 0;
+}
+
+inline std::string unix_socket_path(const std::string& host) {
+    return host.substr(5);
+}
+
+inline SocketProbe probe_socket(stream_socket& socket) {
+    if (!socket.is_open()) {
+        return SocketProbe::Closed;
+    }
+
+    boost::system::error_code ec;
+    socket.non_blocking(true, ec);
+    if (ec) {
+        return SocketProbe::Closed;
+    }
+
+    char byte;
+    std::size_t bytes = socket.receive(boost::asio::buffer(&byte, 1), boost::asio::socket_base::message_peek, ec);
+
+    boost::system::error_code restore_ec;
+    socket.non_blocking(false, restore_ec);
+
+    if (ec == boost::asio::error::would_block) {
+        return restore_ec ? SocketProbe::Closed : SocketProbe::Idle;
+    }
+    // 读到 0 字节即对端已关闭
+    if (ec || bytes == 0 || restore_ec) {
+        return SocketProbe::Closed;
+    }
+    return SocketProbe::Readable;
+}
+
+inline std::string http_host_header(const std::string& host) {
+    return is_unix_endpoint(host) ? std::string("localhost") : host;
+}
+
+inline endpoint_list resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                                       const std::string& host,
+                                       const std::string& port)
+{
+    endpoint_list endpoints;
+
+    if (is_unix_endpoint(host)) {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        endpoints.push_back(boost::asio::local::stream_protocol::endpoint(unix_socket_path(host)));
+        return endpoints;
+#else
+        throw boost::system::system_error(boost::asio::error::operation_not_supported);
+#endif
+    }
+
+    auto const results = resolver.resolve(host, port);
+    for (const auto& entry : results) {
+        endpoints.push_back(entry.endpoint());
+    }
+    return endpoints;
+}
+
+inline void async_resolve_endpoints(boost::asio::ip::tcp::resolver& resolver,
+                                    const std::string& host,
+                                    const std::string& port,
+                                    std::function<void(boost::system::error_code, endpoint_list)> handler)
+{
+    if (is_unix_endpoint(host)) {
+        // 不需要解析，仍通过执行器回调，保持异步语义
+        boost::system::error_code ec;
+        endpoint_list endpoints;
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        endpoints.push_back(boost::asio::local::stream_protocol::endpoint(unix_socket_path(host)));
+#else
+        ec = boost::asio::error::operation_not_supported;
+#endif
+        boost::asio::post(resolver.get_executor(), std::bind(handler, ec, std::move(endpoints)));
+        return;
+    }
+
+    resolver.async_resolve(host, port,
+        [handler](boost::system::error_code ec, boost::asio::ip::tcp::resolver::results_type results) {
+            endpoint_list endpoints;
+            for (const auto& entry : results) {
+                endpoints.push_back(entry.endpoint());
+            }
+            handler(ec, std::move(endpoints));
+        }
+    );
+}
+
+} // namespace detail
+} // namespace jsonrpc
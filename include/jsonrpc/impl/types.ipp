@@ -66,7 +66,7 @@ inline Request Request::from_json(const boost::json::value& jv) {
     std::string method(obj.at("method").as_string().c_str());
 
     // 提取 params（可选）
-    boost::json::value params = nullptr;
+    boost::json::value params(nullptr, jv.storage());
     if (obj.contains("params")) {
         params = obj.at("params");
         // params 必须是 array 或 object
@@ -206,8 +206,8 @@ inline Response Response::from_json(const boost::json::value& jv) {
     }
 }
 
-inline boost::json::object Response::to_json() const {
-    boost::json::object obj;
+inline boost::json::object Response::to_json(boost::json::storage_ptr sp) const {
+    boost::json::object obj(std::move(sp));
     obj["jsonrpc"] = "2.0";
 
     if (is_error_) {
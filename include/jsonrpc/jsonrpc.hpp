@@ -14,8 +14,16 @@
 #include <jsonrpc/config.hpp>
 #include <jsonrpc/errors.hpp>
 #include <jsonrpc/types.hpp>
+#include <jsonrpc/call_context.hpp>
+#include <jsonrpc/responder.hpp>
+#include <jsonrpc/transport.hpp>
+#include <jsonrpc/endpoint.hpp>
+#include <jsonrpc/retry.hpp>
+#include <jsonrpc/concurrency_limit.hpp>
+#include <jsonrpc/priority.hpp>
 #include <jsonrpc/server.hpp>
 #include <jsonrpc/client.hpp>
+#include <jsonrpc/sharded_client.hpp>
 
 /**
  * @namespace jsonrpc
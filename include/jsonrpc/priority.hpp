@@ -0,0 +1,52 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <cstddef>
+
+/**
+ * @file priority.hpp
+ * @brief 服务端工作线程池的优先级调度
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 请求的优先级类别
+ */
+enum class Priority {
+    High,    ///< 交互式、对延迟敏感的调用
+    Normal,  ///< 默认
+    Low      ///< 批处理等大流量、可容忍延迟的调用
+};
+
+/**
+ * @brief 各优先级队列之间的出队方式
+ */
+enum class PriorityScheduling {
+    Strict,       ///< 严格优先：高优先级队列非空时低优先级不出队（低优先级可能饿死）
+    WeightedFair  ///< 加权轮转：非空队列按权重比例轮流出队（默认）
+};
+
+/**
+ * @brief 工作线程池的优先级调度策略
+ *
+ * 每个优先级一个 FIFO 队列，空闲的工作线程按本策略从中取出下一个调用。
+ * 所有请求都是 Normal 时与单个 FIFO 队列的行为相同。
+ */
+struct SchedulingPolicy {
+    SchedulingPolicy()
+        : mode(PriorityScheduling::WeightedFair)
+        , high_weight(8)
+        , normal_weight(4)
+        , low_weight(1)
+    {}
+
+    PriorityScheduling mode;    ///< 出队方式
+    std::size_t high_weight;    ///< WeightedFair：High 队列的权重
+    std::size_t normal_weight;  ///< WeightedFair：Normal 队列的权重
+    std::size_t low_weight;     ///< WeightedFair：Low 队列的权重（权重为 0 按 1 计）
+};
+
+} // namespace jsonrpc
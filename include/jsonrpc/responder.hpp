@@ -0,0 +1,201 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <jsonrpc/errors.hpp>
+#include <jsonrpc/detail/type_converter.hpp>
+#include <boost/json.hpp>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @file responder.hpp
+ * @brief 异步方法的响应器
+ *
+ * 异步方法通过 Responder 在任意线程、任意时刻返回结果。
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+namespace detail {
+
+/**
+ * @brief 方法调用完成回调
+ *
+ * 第一个参数非空表示调用失败（Error 或其他异常），否则第二个参数为 JSON 结果。
+ */
+typedef std::function<void(std::exception_ptr, boost::json::value)> InvokeHandler;
+
+/**
+ * @brief 响应器共享状态
+ *
+ * 保证完成回调恰好被调用一次：所有 Responder 副本销毁时若仍未回复，
+ * 自动以 InternalError 完成，避免客户端永远等不到响应。
+ */
+class ResponderState {
+public:
+    explicit ResponderState(InvokeHandler handler)
+        : handler_(std::move(handler))
+        , done_(false)
+    {}
+
+    ~ResponderState() {
+        if (!done_.exchange(true, std::memory_order_acq_rel)) {
+            try {
+                handler_(std::make_exception_ptr(Error(ErrorCode::InternalError, "异步方法未返回结果")),
+                         boost::json::value());
+            } catch (...) {
+            }
+        }
+    }
+
+    ResponderState(const ResponderState&) = delete;
+    ResponderState& operator=(const ResponderState&) = delete;
+
+    /**
+     * @brief 完成调用
+     * @return 若此前已完成返回 false（本次结果被丢弃）
+     */
+    bool complete(std::exception_ptr error, boost::json::value result) {
+        if (done_.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        InvokeHandler handler = std::move(handler_);
+        handler(std::move(error), std::move(result));
+        return true;
+    }
+
+    bool is_done() const {
+        return done_.load(std::memory_order_acquire);
+    }
+
+private:
+    InvokeHandler handler_;
+    std::atomic<bool> done_;
+};
+
+} // namespace detail
+
+// ============================================================================
+// Responder
+// ============================================================================
+
+/**
+ * @brief 异步方法的响应器
+ *
+ * 作为异步方法的最后一个参数传入，可拷贝、可跨线程传递。
+ * 调用 reply() 或 reply_error() 后服务端才会写回响应；
+ * 若所有副本都已销毁仍未回复，服务端返回 InternalError。
+ *
+ * 使用示例：
+ * @code
+ * server.register_async_method("query", [](std::string sql, jsonrpc::Responder<int> responder) {
+ *     db.async_query(sql, [responder](int rows) mutable { responder.reply(rows); });
+ * });
+ * @endcode
+ *
+ * @tparam R 结果类型（可为 void）
+ */
+template<typename R>
+class Responder {
+public:
+    explicit Responder(std::shared_ptr<detail::ResponderState> state)
+        : state_(std::move(state))
+    {}
+
+    /**
+     * @brief 返回成功结果
+     * @param value 结果值
+     * @throws std::logic_error 已经回复过
+     */
+    void reply(const R& value) {
+        complete(std::exception_ptr(), detail::json_converter<R>::to_json(value));
+    }
+
+    /**
+     * @brief 返回错误
+     * @param error JSON-RPC 错误
+     * @throws std::logic_error 已经回复过
+     */
+    void reply_error(const Error& error) {
+        complete(std::make_exception_ptr(error), boost::json::value());
+    }
+
+    /**
+     * @brief 是否已经回复
+     */
+    bool replied() const {
+        return state_->is_done();
+    }
+
+private:
+    void complete(std::exception_ptr error, boost::json::value result) {
+        if (!state_->complete(std::move(error), std::move(result))) {
+            throw std::logic_error("Responder 已经回复过");
+        }
+    }
+
+    std::shared_ptr<detail::ResponderState> state_;
+};
+
+/**
+ * @brief 特化：无返回值的异步方法
+ */
+template<>
+class Responder<void> {
+public:
+    explicit Responder(std::shared_ptr<detail::ResponderState> state)
+        : state_(std::move(state))
+    {}
+
+    /**
+     * @brief 返回成功（结果为 null）
+     * @throws std::logic_error 已经回复过
+     */
+    void reply() {
+        complete(std::exception_ptr(), detail::json_converter<void>::to_json());
+    }
+
+    /**
+     * @brief 返回错误
+     * @param error JSON-RPC 错误
+     * @throws std::logic_error 已经回复过
+     */
+    void reply_error(const Error& error) {
+        complete(std::make_exception_ptr(error), boost::json::value());
+    }
+
+    /**
+     * @brief 是否已经回复
+     */
+    bool replied() const {
+        return state_->is_done();
+    }
+
+private:
+    void complete(std::exception_ptr error, boost::json::value result) {
+        if (!state_->complete(std::move(error), std::move(result))) {
+            throw std::logic_error("Responder 已经回复过");
+        }
+    }
+
+    std::shared_ptr<detail::ResponderState> state_;
+};
+
+namespace detail {
+
+/**
+ * @brief 判断类型是否为 Responder
+ */
+template<typename T>
+struct is_responder : std::false_type {};
+
+template<typename R>
+struct is_responder<Responder<R>> : std::true_type {};
+
+} // namespace detail
+} // namespace jsonrpc
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @file retry.hpp
+ * @brief 客户端的重试与对冲请求策略
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 网络错误时的重试策略（只作用于标记为幂等的方法）
+ *
+ * 第 n 次重试前等待 [0, min(max_backoff, initial_backoff × multiplier^(n-1))] 内的随机时长
+ * （full jitter），避免大量客户端同时重试。服务端返回的 RPC 错误不重试。
+ */
+struct RetryPolicy {
+    RetryPolicy()
+        : max_attempts(1)
+        , initial_backoff(50)
+        , max_backoff(2000)
+        , multiplier(2.0)
+    {}
+
+    std::size_t max_attempts;                   ///< 最多尝试次数（含第一次，1 表示不重试）
+    std::chrono::milliseconds initial_backoff;  ///< 第一次重试的退避上限
+    std::chrono::milliseconds max_backoff;      ///< 退避上限的最大值
+    double multiplier;                          ///< 每次重试退避上限的增长倍数
+};
+
+/**
+ * @brief 对冲请求策略（只作用于标记为幂等的方法）
+ *
+ * 请求发出后 delay 内没有响应时，再发出一份副本（经另一条连接，多端点时由负载均衡
+ * 选择端点），最先到达的响应作为结果，其余副本的响应被丢弃。
+ * delay 取最近成功调用延迟的 percentile 分位数，且不小于 min_delay；
+ * 样本不足时使用 min_delay。
+ */
+struct HedgePolicy {
+    HedgePolicy()
+        : max_hedges(1)
+        , percentile(95.0)
+        , min_delay(5)
+    {}
+
+    std::size_t max_hedges;                 ///< 每次调用最多额外发出的副本数（0 表示关闭对冲）
+    double percentile;                      ///< 触发对冲的延迟分位数（0~100）
+    std::chrono::milliseconds min_delay;    ///< 对冲延迟的下限
+};
+
+} // namespace jsonrpc
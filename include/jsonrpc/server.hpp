@@ -3,6 +3,9 @@
 #include <jsonrpc/config.hpp>
 #include <jsonrpc/types.hpp>
 #include <jsonrpc/errors.hpp>
+#include <jsonrpc/priority.hpp>
+#include <jsonrpc/responder.hpp>
+#include <jsonrpc/transport.hpp>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -25,6 +28,14 @@ namespace asio {
 
 namespace jsonrpc {
 
+/**
+ * @brief 单个（非批量）请求的调度方式
+ */
+enum class SingleRequestDispatch {
+    Pooled,  ///< 投递一次到线程池执行（默认），慢方法不会阻塞 I/O 线程
+    Inline   ///< 直接在 I/O 线程执行，没有线程切换，适合执行极快的方法
+};
+
 /**
  * @brief JSON-RPC 服务端
  *
@@ -57,6 +68,9 @@ public:
 
     /**
      * @brief 析构函数
+     *
+     * 停止服务器并关闭所有连接，不再执行新的调用；尚未回复的异步方法最多等待 5 秒
+     * （Responder 回复或全部副本销毁），超时后放弃，之后的回复被丢弃。
      */
     ~Server();
 
@@ -67,11 +81,13 @@ public:
     /**
      * @brief 注册 RPC 方法
      *
-     * 支持任意函数签名，参数和返回值会自动转换。
+     * 支持任意函数签名，参数和返回值会自动转换。第一个参数可以声明为 const CallContext&，
+     * 用于读取调用方的剩余等待时间；排队超过该时间的请求不会执行。
      *
      * @tparam Func 函数类型（函数指针、lambda、std::function 等）
      * @param name 方法名
      * @param func 函数对象
+     * @throws std::logic_error thread-per-core 模式下服务器运行期间注册
      *
      * @code
      * // 普通函数
@@ -89,6 +105,32 @@ public:
     template<typename Func>
     void register_method(const std::string& name, Func&& func);
 
+    /**
+     * @brief 注册异步 RPC 方法
+     *
+     * 方法的最后一个参数为 Responder<R>，其余参数与 register_method() 一样自动转换。
+     * 方法可以立即返回，之后在任意线程调用 responder.reply() / reply_error()，
+     * 服务端收到回复后才写回响应，等待期间不占用工作线程。
+     * 服务器析构时最多等待 5 秒让 Responder 回复或销毁，期间继续驱动服务器的事件循环；
+     * 超时后未回复的调用被放弃，服务器销毁后 Responder 仍可安全回复（结果被丢弃）。
+     *
+     * @tparam Func 函数类型，签名为 void([const CallContext&,] Args..., Responder<R>)
+     * @param name 方法名
+     * @param func 函数对象
+     * @throws std::logic_error thread-per-core 模式运行期间注册
+     *
+     * 使用示例：
+     * @code
+     * server.register_async_method("fetch", [&](int key, jsonrpc::Responder<std::string> responder) {
+     *     cache.async_get(key, [responder](std::string value) mutable {
+     *         responder.reply(value);
+     *     });
+     * });
+     * @endcode
+     */
+    template<typename Func>
+    void register_async_method(const std::string& name, Func&& func);
+
     /**
      * @brief 运行服务器（阻塞）
      *
@@ -138,11 +180,127 @@ public:
      */
     void set_batch_concurrency(std::size_t threads);
 
+    /**
+     * @brief 设置方法的默认优先级
+     *
+     * 工作线程池为每个优先级维护一个队列，线程空闲时按 set_priority_scheduling()
+     * 的策略取出下一个调用，交互式的 High 调用不必排在大量 Low 调用之后。
+     * HTTP 传输下调用方可以用 X-Jsonrpc-Priority 头（high / normal / low）
+     * 覆盖本设置；未设置的方法为 Priority::Normal。
+     * Inline 调度的单个请求不经过线程池，不受优先级影响。
+     *
+     * @param name 方法名（可以在注册方法之前设置）
+     * @param priority 优先级
+     * @throws std::logic_error thread-per-core 模式运行期间设置
+     *
+     * 使用示例：
+     * @code
+     * server.set_method_priority("lookup", jsonrpc::Priority::High);
+     * server.set_method_priority("reindex", jsonrpc::Priority::Low);
+     * @endcode
+     */
+    void set_method_priority(const std::string& name, Priority priority);
+
+    /**
+     * @brief 设置工作线程池的优先级调度策略
+     *
+     * @param policy 调度策略（默认按 8:4:1 加权轮转）
+     * @throws std::logic_error 当服务器正在运行时调用
+     */
+    void set_priority_scheduling(const SchedulingPolicy& policy);
+
+    /**
+     * @brief 设置 I/O 线程数
+     *
+     * 多个线程共同运行同一个 io_context，分担 accept、HTTP 解析和
+     * JSON 序列化；每个连接绑定独立的 strand，会话内回调不会并发执行。
+     * run() 会让调用线程作为其中一个 I/O 线程。
+     *
+     * @param threads I/O 线程数，最小为 1（默认 1）
+     * @throws std::logic_error 当服务器正在运行时调用
+     */
+    void set_io_threads(std::size_t threads);
+
+    /**
+     * @brief 获取当前配置的 I/O 线程数
+     */
+    std::size_t io_threads() const;
+
+    /**
+     * @brief 启用 thread-per-core 模式（share-nothing）
+     *
+     * 启用后 io_threads() 个线程各自拥有独立的 io_context 和使用
+     * SO_REUSEPORT 绑定同一端口的 acceptor，由内核在各核心之间分配连接；
+     * 会话及其缓冲区只在所属线程上访问，线程会尽量绑定到对应 CPU 核心。
+     * 运行期间方法表为只读（查找无需加锁），此时调用 register_method()
+     * 会抛出 std::logic_error。get_io_context() 返回第 0 个核心的 io_context。
+     *
+     * @param enable 是否启用
+     * @throws std::logic_error 服务器正在运行，或平台不支持 SO_REUSEPORT
+     */
+    void set_per_core_acceptors(bool enable);
+
+    /**
+     * @brief 是否启用了 thread-per-core 模式
+     */
+    bool per_core_acceptors() const;
+
+    /**
+     * @brief 设置单个（非批量）请求的调度方式
+     *
+     * 单个请求不经过批量路径：Pooled 只做一次线程池投递，
+     * Inline 直接在 I/O 线程调用方法（方法耗时会阻塞该线程上的其他连接）。
+     * 批量请求始终在线程池中并行执行。
+     *
+     * @param mode 调度方式（默认 SingleRequestDispatch::Pooled）
+     * @throws std::logic_error 当服务器正在运行时调用
+     */
+    void set_single_request_dispatch(SingleRequestDispatch mode);
+
+    /**
+     * @brief 获取单个请求的调度方式
+     */
+    SingleRequestDispatch single_request_dispatch() const;
+
+    /**
+     * @brief 设置传输方式
+     *
+     * 默认 Transport::Http。原始 TCP 传输（长度前缀 / NDJSON）下同一连接可并发处理多个请求，
+     * 响应按完成顺序写回，客户端按 id 匹配；客户端必须使用相同的传输方式。
+     *
+     * @param transport 传输方式
+     * @throws std::logic_error 当服务器正在运行时调用
+     */
+    void set_transport(Transport transport);
+
+    /**
+     * @brief 获取传输方式
+     */
+    Transport transport() const;
+
+    /**
+     * @brief 额外监听一个 Unix 域套接字
+     *
+     * 与 TCP 端口同时服务，共用同一个方法注册表、传输方式与调度配置；
+     * 同机调用方经由 Unix 域套接字连接可绕过 TCP 协议栈。可多次调用以监听多个路径。
+     * 启动时只删除无人监听的残留套接字文件，停止时删除自己创建的文件；
+     * 路径上是其他文件或仍有服务器在监听时，与 TCP 端口被占用一样抛出异常。
+     * 套接字文件在 start()/run() 时创建，创建失败时抛出 boost::system::system_error。
+     * thread-per-core 模式下 Unix 域套接字连接由第 0 个核心处理。
+     *
+     * 客户端以 jsonrpc::Client client("unix:/path/to/socket", 0) 连接。
+     *
+     * @param path 套接字文件路径
+     * @throws std::logic_error 服务器正在运行，或平台不支持 Unix 域套接字
+     */
+    void listen_unix(const std::string& path);
+
     /**
      * @brief 设置日志回调
      *
      * 用于捕获网络错误、无效请求等调试信息。
-     * 回调会在 I/O 线程执行，需要注意线程安全。
+     * 回调会在 I/O 线程执行，需要注意线程安全；
+     * 多 I/O 线程模式下可能被并发调用。
      *
      * @param logger 日志回调（传入空函数可移除）
      */
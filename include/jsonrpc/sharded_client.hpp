@@ -0,0 +1,156 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+#include <jsonrpc/client.hpp>
+#include <jsonrpc/endpoint.hpp>
+#include <jsonrpc/detail/hash_ring.hpp>
+#include <boost/json.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file sharded_client.hpp
+ * @brief 按请求键路由到分片的 JSON-RPC 客户端
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 分片客户端
+ *
+ * 数据按键分布在多台服务器上时，每次调用需要发往拥有该键的分片。
+ * ShardedClient 为每个分片持有一个 Client（各自的长连接、连接池与 1 个内部 I/O 线程），
+ * 从调用参数中提取键，经一致性哈希环（带虚拟节点）选择分片。
+ * 同一组分片在不同进程中得到相同的路由；增删分片只移动约 1/N 的键。
+ *
+ * 使用示例：
+ * @code
+ * jsonrpc::ShardedClient client({{"10.0.0.1", 8080}, {"10.0.0.2", 8080}});
+ * client.set_key_extractor("get", jsonrpc::ShardedClient::positional_key(0));
+ * auto value = client.call<std::string>("get", "user:42");
+ *
+ * // 多键调用按分片拆开并行发送，结果按键的顺序合并
+ * std::vector<std::string> values = client.scatter_gather<std::string>("get_many", keys);
+ * @endcode
+ */
+class JSONRPC_DECL ShardedClient {
+public:
+    /**
+     * @brief 键提取函数：从调用的位置参数中取出路由键
+     */
+    typedef std::function<std::string(const boost::json::array& params)> KeyExtractor;
+
+    /**
+     * @brief 构造分片客户端
+     *
+     * @param shards 各分片的服务端端点（顺序不影响路由，以 "host:port" 决定在环上的位置）
+     * @param virtual_nodes 每个分片的虚拟节点数（默认 160）
+     * @throws std::invalid_argument shards 为空
+     */
+    explicit ShardedClient(const std::vector<Endpoint>& shards, std::size_t virtual_nodes = 160);
+
+    ~ShardedClient();
+
+    // 禁止拷贝
+    ShardedClient(const ShardedClient&) = delete;
+    ShardedClient& operator=(const ShardedClient&) = delete;
+
+    /**
+     * @brief 取第 index 个位置参数作为键（字符串取其内容，其他类型取 JSON 文本）
+     */
+    static KeyExtractor positional_key(std::size_t index);
+
+    /**
+     * @brief 设置方法的键提取函数
+     *
+     * 未设置的方法以第一个位置参数作为键。
+     *
+     * @param method 方法名
+     * @param extractor 键提取函数
+     */
+    void set_key_extractor(const std::string& method, KeyExtractor extractor);
+
+    /**
+     * @brief 分片数
+     */
+    std::size_t shard_count() const;
+
+    /**
+     * @brief 键所属分片的下标
+     */
+    std::size_t shard_for(const std::string& key) const;
+
+    /**
+     * @brief 第 index 个分片的客户端（用于配置超时、传输方式等，或直接发起调用）
+     *
+     * 分片客户端已启用内部 I/O 线程，不能再调用其 run()/poll()。
+     */
+    Client& shard(std::size_t index);
+
+    /**
+     * @brief 同步调用：按键路由到所属分片
+     *
+     * @throws Error RPC 错误或网络错误
+     * @throws std::invalid_argument 无法从参数中提取键
+     */
+    template<typename Result, typename... Args>
+    Result call(const std::string& method, Args&&... args);
+
+    /**
+     * @brief 发送通知：按键路由到所属分片
+     */
+    template<typename... Args>
+    void notify(const std::string& method, Args&&... args);
+
+    /**
+     * @brief 多键调用的分散与合并
+     *
+     * 把 keys 按所属分片分组，并行地向每个涉及的分片调用 method(该分片的键数组)，
+     * 服务端应返回与键数组等长、顺序对应的结果数组。全部完成后按 keys 的原顺序合并。
+     *
+     * @tparam Value 单个键的结果类型
+     * @tparam Key 键类型
+     * @param method 方法名（服务端签名形如 std::vector<Value>(const std::vector<Key>&)）
+     * @param keys 键
+     * @return 与 keys 一一对应的结果
+     * @throws Error 任一分片返回错误、网络错误或结果数组长度不符
+     */
+    template<typename Value, typename Key>
+    std::vector<Value> scatter_gather(const std::string& method, const std::vector<Key>& keys);
+
+private:
+    /**
+     * @brief JSON 值转换为路由键
+     */
+    static std::string key_of(const boost::json::value& value);
+
+    std::string extract_key(const std::string& method, const boost::json::array& params) const;
+
+    Response route(const std::string& method, boost::json::array params);
+
+    void route_notify(const std::string& method, boost::json::array params);
+
+    /**
+     * @brief 向各分片并行发送子请求，返回每个分片的结果数组（未涉及的分片为 null）
+     */
+    std::vector<boost::json::value> gather(const std::string& method, std::vector<boost::json::array>& subsets);
+
+    std::vector<std::unique_ptr<Client>> shards_;                   ///< 各分片的客户端
+    detail::HashRing ring_;                                         ///< 一致性哈希环
+    mutable std::mutex mutex_;                                      ///< 保护 extractors_
+    std::unordered_map<std::string, KeyExtractor> extractors_;      ///< 方法 -> 键提取函数
+};
+
+} // namespace jsonrpc
+
+// Header-only 模式下包含实现
+#ifdef JSONRPC_HEADER_ONLY
+#include <jsonrpc/impl/sharded_client.ipp>
+#endif
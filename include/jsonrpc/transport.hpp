@@ -0,0 +1,34 @@
+#pragma once
+
+#include <jsonrpc/config.hpp>
+
+/**
+ * @file transport.hpp
+ * @brief 传输方式与相关选项
+ *
+ * @author 无事情小神仙
+ */
+
+namespace jsonrpc {
+
+/**
+ * @brief 服务端与客户端之间的传输方式
+ *
+ * 两端必须使用相同的传输方式。原始 TCP 传输省去 HTTP 头的解析与生成，
+ * 一个连接上可同时有多个请求在途，响应按 id 匹配（可能乱序返回）。
+ */
+enum class Transport {
+    Http,              ///< HTTP/1.1 POST（默认）
+    LengthPrefixed,    ///< 原始 TCP，每帧为 4 字节大端长度 + JSON 文本
+    NewlineDelimited   ///< 原始 TCP，每行一个 JSON 文本（NDJSON）
+};
+
+/**
+ * @brief 客户端通知队列已满时的处理方式
+ */
+enum class NotifyOverflow {
+    Block,  ///< notify() 阻塞，直到队列有空位（默认）
+    Drop    ///< 丢弃本条通知并计数，notify() 立即返回
+};
+
+} // namespace jsonrpc
@@ -63,6 +63,9 @@ public:
 
     /**
      * @brief 从 JSON 值解析请求
+     *
+     * params 与 id 使用 jv 的存储（storage_ptr），与源值同生命周期。
+     *
      * @param jv JSON 值
      * @return Request 对象
      * @throws Error 如果解析失败
@@ -140,9 +143,10 @@ public:
 
     /**
      * @brief 转换为 JSON 对象
+     * @param sp 结果对象使用的存储（默认堆）
      * @return JSON-RPC 响应对象
      */
-    boost::json::object to_json() const;
+    boost::json::object to_json(boost::json::storage_ptr sp = {}) const;
 
 private:
     bool is_error_;
@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/call_batcher.hpp>
+#include <jsonrpc/impl/call_batcher.ipp>
+#endif
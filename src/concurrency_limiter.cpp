@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/concurrency_limiter.hpp>
+#include <jsonrpc/impl/concurrency_limiter.ipp>
+#endif
@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/connection_pool.hpp>
+#include <jsonrpc/impl/connection_pool.ipp>
+#endif
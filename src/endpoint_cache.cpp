@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/endpoint_cache.hpp>
+#include <jsonrpc/impl/endpoint_cache.ipp>
+#endif
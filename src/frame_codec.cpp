@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/frame_codec.hpp>
+#include <jsonrpc/impl/frame_codec.ipp>
+#endif
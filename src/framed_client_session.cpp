@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/framed_client_session.hpp>
+#include <jsonrpc/impl/framed_client_session.ipp>
+#endif
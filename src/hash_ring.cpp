@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/hash_ring.hpp>
+#include <jsonrpc/impl/hash_ring.ipp>
+#endif
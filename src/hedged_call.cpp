@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/hedged_call.hpp>
+#include <jsonrpc/impl/hedged_call.ipp>
+#endif
@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/load_balancer.hpp>
+#include <jsonrpc/impl/load_balancer.ipp>
+#endif
@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/notification_sender.hpp>
+#include <jsonrpc/impl/notification_sender.ipp>
+#endif
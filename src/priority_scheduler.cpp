@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/priority_scheduler.hpp>
+#include <jsonrpc/impl/priority_scheduler.ipp>
+#endif
@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/sharded_client.hpp>
+#include <jsonrpc/impl/sharded_client.ipp>
+#endif
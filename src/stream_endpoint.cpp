@@ -0,0 +1,4 @@
+#ifndef JSONRPC_HEADER_ONLY
+#include <jsonrpc/detail/stream_endpoint.hpp>
+#include <jsonrpc/impl/stream_endpoint.ipp>
+#endif
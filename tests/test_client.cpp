@@ -1,10 +1,18 @@
 #include <jsonrpc/jsonrpc.hpp>
+#include <jsonrpc/detail/concurrency_limiter.hpp>
+#include <jsonrpc/detail/endpoint_cache.hpp>
+#include <jsonrpc/detail/framed_client_session.hpp>
+#include <jsonrpc/detail/hash_ring.hpp>
+#include <jsonrpc/detail/pending_table.hpp>
 #include <gtest/gtest.h>
+#include <boost/asio/use_future.hpp>
 #include <atomic>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <thread>
 #include <string>
+#include <vector>
 
 using namespace jsonrpc;
 
@@ -391,3 +399,850 @@ TEST_F(JsonRpcServerFixture, TimeoutError) {
     // 不要求必然抛错，但不应长时间阻塞
     EXPECT_LT(elapsed, 500);
 }
+
+TEST_F(JsonRpcServerFixture, KeepAliveConnectionsAreReused) {
+    Client client("127.0.0.1", 19090);
+    client.preconnect(2);
+    EXPECT_EQ(client.idle_connections(), 2u);
+
+    // 同步与异步调用复用空闲连接，完成后归还
+    EXPECT_EQ(client.call<int>("add", 1, 2), 3);
+    EXPECT_EQ(client.idle_connections(), 2u);
+
+    int completed = 0;
+    for (int i = 0; i < 4; ++i) {
+        client.async_call("add", [&completed](const Response& response) {
+            EXPECT_FALSE(response.is_error());
+            ++completed;
+        }, i, i);
+    }
+    client.run();
+    EXPECT_EQ(completed, 4);
+    EXPECT_EQ(client.idle_connections(), 4u);
+
+    client.set_max_idle_connections(1);
+    EXPECT_EQ(client.idle_connections(), 1u);
+
+    client.set_max_idle_connections(0);
+    EXPECT_EQ(client.call<int>("add", 2, 3), 5);
+    EXPECT_EQ(client.idle_connections(), 0u);
+}
+
+TEST(ClientPoolTest, StaleConnectionsAreReplaced) {
+    Client client("127.0.0.1", 19220);
+    {
+        Server server(19220, "127.0.0.1");
+        server.register_method("ping", []() { return std::string("pong"); });
+        server.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(client.call<std::string>("ping"), "pong");
+        EXPECT_EQ(client.idle_connections(), 1u);
+    }
+
+    // 服务端重启后，池中的旧连接已被对端关闭，调用应透明地建立新连接
+    Server server(19220, "127.0.0.1");
+    server.register_method("ping", []() { return std::string("pong again"); });
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(client.call<std::string>("ping"), "pong again");
+
+    client.set_idle_timeout(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(client.call<std::string>("ping"), "pong again");
+    server.stop();
+}
+
+TEST_F(JsonRpcServerFixture, PipelinedAsyncCalls) {
+    Client client("127.0.0.1", 19090);
+    client.set_pipelining(true);
+    EXPECT_TRUE(client.pipelining());
+
+    // 响应按请求顺序返回
+    std::vector<int> results;
+    for (int i = 0; i < 50; ++i) {
+        client.async_call("add", [&results](const Response& response) {
+            ASSERT_FALSE(response.is_error()) << response.error().message();
+            results.push_back(static_cast<int>(response.result().as_int64()));
+        }, i, 0);
+    }
+    client.async_call("throw_error", [&results](const Response& response) {
+        EXPECT_TRUE(response.is_error());
+        results.push_back(-1);
+    });
+    client.run();
+
+    ASSERT_EQ(results.size(), 51u);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(results[i], i);
+    }
+    EXPECT_EQ(results[50], -1);
+
+    // 超时的调用不影响同一连接上后续的调用
+    client.set_timeout(std::chrono::milliseconds(50));
+    bool timed_out = false;
+    client.async_call("delay", [&timed_out](const Response& response) {
+        timed_out = response.is_error();
+    }, 200);
+    client.run();
+    EXPECT_TRUE(timed_out);
+
+    client.set_timeout(std::chrono::seconds(5));
+    int late = 0;
+    client.async_call("add", [&late](const Response& response) {
+        late = static_cast<int>(response.result().as_int64());
+    }, 20, 22);
+    client.run();
+    EXPECT_EQ(late, 42);
+}
+
+TEST(PendingTableTest, InsertTakeAndDrain) {
+    detail::PendingTable<int> table;
+    int value = 0;
+    EXPECT_FALSE(table.take(1, value));
+
+    // 连续 id 与相互冲突的 id（低位相同）混合插入，触发扩容与回移
+    for (std::int64_t id = 1; id <= 100; ++id) {
+        table.insert(id, static_cast<int>(id));
+        table.insert(id << 20, static_cast<int>(id) + 1000);
+    }
+    EXPECT_EQ(table.size(), 200u);
+
+    for (std::int64_t id = 1; id <= 100; id += 2) {
+        ASSERT_TRUE(table.take(id, value));
+        EXPECT_EQ(value, id);
+        EXPECT_FALSE(table.take(id, value));
+    }
+    for (std::int64_t id = 1; id <= 100; ++id) {
+        ASSERT_TRUE(table.take(id << 20, value));
+        EXPECT_EQ(value, id + 1000);
+    }
+    EXPECT_EQ(table.size(), 50u);
+
+    auto rest = table.drain();
+    EXPECT_EQ(rest.size(), 50u);
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.take(2, value));
+}
+
+TEST_F(JsonRpcServerFixture, AutoBatchingFansOutResponses) {
+    Client client("127.0.0.1", 19090);
+    client.set_auto_batching(4, std::chrono::milliseconds(80));
+
+    // 凑满一批立即发送
+    std::vector<int> results(8, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 8; ++i) {
+        client.async_call("add", [&results, i](const Response& response) {
+            ASSERT_FALSE(response.is_error()) << response.error().message();
+            results[i] = static_cast<int>(response.result().as_int64());
+        }, i, 100);
+    }
+    client.run();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(80));
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(results[i], i + 100);
+    }
+
+    // 不足一批时等待 max_delay 后发送；批内的错误只影响对应调用
+    bool failed = false;
+    int sum = 0;
+    start = std::chrono::steady_clock::now();
+    client.async_call("throw_error", [&failed](const Response& response) {
+        failed = response.is_error();
+    });
+    client.async_call("add", [&sum](const Response& response) {
+        sum = static_cast<int>(response.result().as_int64());
+    }, 1, 2);
+    client.run();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(70));
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(sum, 3);
+}
+
+TEST_F(JsonRpcServerFixture, NotifyQueueSendsInBackground) {
+    Client client("127.0.0.1", 19090);
+    int initial_count = notify_counter_->load();
+
+    // 入队即返回，由后台线程在一条长连接上发送
+    const int count = 200;
+    for (int i = 0; i < count; ++i) {
+        client.notify("notify_handler");
+    }
+    client.flush_notifications();
+    EXPECT_EQ(client.dropped_notifications(), 0u);
+
+    for (int i = 0; i < 50 && notify_counter_->load() - initial_count < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(notify_counter_->load() - initial_count, count);
+
+    // 丢弃策略：每条通知要么送达，要么计入丢弃数
+    client.set_notify_queue(1, NotifyOverflow::Drop);
+    initial_count = notify_counter_->load();
+    for (int i = 0; i < count; ++i) {
+        client.notify("notify_handler");
+    }
+    client.flush_notifications();
+
+    int expected = count - static_cast<int>(client.dropped_notifications());
+    for (int i = 0; i < 50 && notify_counter_->load() - initial_count < expected; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(notify_counter_->load() - initial_count, expected);
+}
+
+TEST_F(JsonRpcServerFixture, AsyncCallWithCompletionTokens) {
+    Client client("127.0.0.1", 19090);
+
+    std::future<int> sum = client.async_call<int>("add", boost::asio::use_future, 1, 2);
+    std::future<int> failed = client.async_call<int>("throw_error", boost::asio::use_future);
+
+    std::string echoed;
+    client.async_call<std::string>("echo", [&echoed](boost::system::error_code ec, std::string value) {
+        EXPECT_FALSE(ec);
+        echoed = value;
+    }, std::string("hello"));
+
+    bool got_response = false;
+    client.async_call<Response>("no_params", [&got_response](boost::system::error_code ec, Response response) {
+        EXPECT_FALSE(ec);
+        got_response = !response.is_error() && response.result().as_int64() == 42;
+    });
+
+    boost::system::error_code missing;
+    client.async_call<void>("no_such_method", [&missing](boost::system::error_code ec) {
+        missing = ec;
+    });
+
+    // 返回值类型不匹配
+    boost::system::error_code mismatch;
+    client.async_call<std::string>("add", [&mismatch](boost::system::error_code ec, std::string) {
+        mismatch = ec;
+    }, 1, 2);
+
+    client.run();
+
+    EXPECT_EQ(sum.get(), 3);
+    try {
+        failed.get();
+        FAIL() << "expected system_error";
+    } catch (const boost::system::system_error& e) {
+        EXPECT_EQ(e.code(), ErrorCode::ServerError);
+    }
+    EXPECT_EQ(echoed, "hello");
+    EXPECT_TRUE(got_response);
+    EXPECT_EQ(missing, ErrorCode::MethodNotFound);
+    EXPECT_EQ(mismatch, ErrorCode::InvalidParams);
+}
+
+#ifdef JSONRPC_HAS_COROUTINES
+TEST_F(JsonRpcServerFixture, AsyncCallWithAwaitable) {
+    Client client("127.0.0.1", 19090);
+
+    int result = 0;
+    boost::asio::co_spawn(client.get_io_context(), [&]() -> boost::asio::awaitable<void> {
+        int a = co_await client.async_call<int>("add", boost::asio::use_awaitable, 20, 1);
+        result = co_await client.async_call<int>("add", boost::asio::use_awaitable, a, 21);
+    }, boost::asio::detached);
+    client.run();
+
+    EXPECT_EQ(result, 42);
+}
+#endif
+
+TEST_F(JsonRpcServerFixture, SharedClientWithIoThreads) {
+    Client client("127.0.0.1", 19090);
+    client.set_io_threads(2);
+    EXPECT_EQ(client.io_threads(), 2u);
+    EXPECT_THROW(client.run(), std::logic_error);
+
+    // 多个应用线程共用一个客户端：同步调用与完成令牌异步调用混用，无需调用 run()
+    const int thread_count = 8;
+    const int calls_per_thread = 20;
+    std::atomic<int> failures(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&client, &failures, t]() {
+            for (int i = 0; i < calls_per_thread; ++i) {
+                std::future<int> async_sum = client.async_call<int>("add", boost::asio::use_future, t, i);
+                if (client.call<int>("multiply", t, i) != t * i || async_sum.get() != t + i) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+
+    // 停止内部线程后恢复由调用方运行事件循环
+    client.set_io_threads(0);
+    int sum = 0;
+    client.async_call("add", [&sum](const Response& response) {
+        sum = static_cast<int>(response.result().as_int64());
+    }, 20, 22);
+    client.run();
+    EXPECT_EQ(sum, 42);
+}
+
+TEST(EndpointCacheTest, CachesAndRefreshesEndpoints) {
+    boost::asio::io_context io_context;
+    boost::asio::ip::tcp::resolver resolver(io_context);
+    auto cache = std::make_shared<detail::EndpointCache>(std::chrono::milliseconds(50));
+
+    auto endpoints = cache->resolve(resolver, "127.0.0.1", "19090");
+    ASSERT_FALSE(endpoints.empty());
+    EXPECT_EQ(cache->size(), 1u);
+
+    // 过期后仍立即返回旧结果，后台刷新
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_EQ(cache->resolve(resolver, "127.0.0.1", "19090"), endpoints);
+
+    bool resolved = false;
+    cache->async_resolve(resolver, "127.0.0.1", "19090",
+        [&resolved, &endpoints](boost::system::error_code ec, detail::endpoint_list result) {
+            EXPECT_FALSE(ec);
+            resolved = result == endpoints;
+        });
+    io_context.run();
+    EXPECT_TRUE(resolved);
+
+    // 连接失败后丢弃；关闭缓存后不再保存
+    for (int i = 0; i < 50 && cache->size() != 0; ++i) {
+        cache->invalidate("127.0.0.1", "19090");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(cache->size(), 0u);
+    cache->set_ttl(std::chrono::milliseconds(0));
+    cache->resolve(resolver, "127.0.0.1", "19090");
+    EXPECT_EQ(cache->size(), 0u);
+}
+
+TEST(ClientBatchingTest, AutoBatchingOverRawTcp) {
+    Server server(19221, "127.0.0.1");
+    server.set_transport(Transport::LengthPrefixed);
+    server.register_method("square", [](int v) { return v * v; });
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Client client("127.0.0.1", 19221);
+    client.set_transport(Transport::LengthPrefixed);
+    client.set_auto_batching(16, std::chrono::milliseconds(2));
+
+    int total = 0;
+    int completed = 0;
+    for (int i = 0; i < 40; ++i) {
+        client.async_call("square", [&total, &completed](const Response& response) {
+            ASSERT_FALSE(response.is_error()) << response.error().message();
+            total += static_cast<int>(response.result().as_int64());
+            ++completed;
+        }, i);
+    }
+    client.run();
+    EXPECT_EQ(completed, 40);
+    EXPECT_EQ(total, 39 * 40 * 79 / 6);
+
+    server.stop();
+}
+
+TEST(ClientLoadBalancingTest, SpreadsCallsAndEjectsDeadEndpoint) {
+    Server first(19222, "127.0.0.1");
+    Server second(19223, "127.0.0.1");
+    first.register_method("whoami", []() { return 1; });
+    second.register_method("whoami", []() { return 2; });
+    first.start();
+    second.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 19224 上没有服务端
+    Client client({Endpoint{"127.0.0.1", 19222}, Endpoint{"127.0.0.1", 19223}, Endpoint{"127.0.0.1", 19224}});
+    client.set_load_balancing(LoadBalancePolicy::RoundRobin);
+    client.set_outlier_ejection(2, std::chrono::seconds(60));
+    client.set_timeout(std::chrono::milliseconds(500));
+
+    int failures = 0;
+    for (int i = 0; i < 6; ++i) {
+        try {
+            client.call<int>("whoami");
+        } catch (const Error&) {
+            ++failures;
+        }
+    }
+    EXPECT_EQ(failures, 2);
+
+    auto status = client.endpoint_status();
+    ASSERT_EQ(status.size(), 3u);
+    EXPECT_EQ(status[2].endpoint.port, 19224);
+    EXPECT_TRUE(status[2].ejected);
+    EXPECT_FALSE(status[0].ejected);
+    EXPECT_GT(status[0].latency.count(), 0);
+
+    // 摘除后只在存活的端点间轮转，异步调用同样统计在途数
+    int seen[3] = {0, 0, 0};
+    for (int i = 0; i < 8; ++i) {
+        client.async_call("whoami", [&seen](const Response& response) {
+            ASSERT_FALSE(response.is_error()) << response.error().message();
+            ++seen[response.result().as_int64()];
+        });
+    }
+    client.run();
+    EXPECT_EQ(seen[1], 4);
+    EXPECT_EQ(seen[2], 4);
+    for (const auto& endpoint : client.endpoint_status()) {
+        EXPECT_EQ(endpoint.outstanding, 0u);
+    }
+
+    EXPECT_THROW(Client(std::vector<Endpoint>()), std::invalid_argument);
+
+    first.stop();
+    second.stop();
+}
+
+TEST(ClientRetryTest, RetriesIdempotentCallsWithBackoff) {
+    Client client("127.0.0.1", 19225);
+    client.set_timeout(std::chrono::milliseconds(500));
+    RetryPolicy retry;
+    retry.max_attempts = 20;
+    retry.initial_backoff = std::chrono::milliseconds(20);
+    retry.max_backoff = std::chrono::milliseconds(100);
+    client.set_retry_policy(retry);
+
+    // 未标记幂等的方法不重试
+    EXPECT_THROW(client.call<int>("ping"), Error);
+
+    // 服务端稍后才启动，重试期间连接被拒绝
+    std::unique_ptr<Server> server;
+    std::thread starter([&server]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        server.reset(new Server(19225, "127.0.0.1"));
+        server->register_method("ping", []() { return 7; });
+        server->start();
+    });
+
+    client.set_idempotent("ping");
+    EXPECT_EQ(client.call<int>("ping"), 7);
+    starter.join();
+
+    // 服务端返回的 RPC 错误不重试
+    EXPECT_THROW(client.call<int>("missing"), Error);
+    client.set_idempotent("missing");
+    try {
+        client.call<int>("missing");
+        FAIL() << "应当抛出 MethodNotFound";
+    } catch (const Error& e) {
+        EXPECT_EQ(e.code(), ErrorCode::MethodNotFound);
+    }
+
+    server->stop();
+}
+
+TEST(ClientRetryTest, HedgesSlowCallsToAnotherEndpoint) {
+    Server slow(19226, "127.0.0.1");
+    Server fast(19227, "127.0.0.1");
+    slow.register_method("lookup", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        return 1;
+    });
+    fast.register_method("lookup", []() { return 2; });
+    slow.start();
+    fast.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Client client({Endpoint{"127.0.0.1", 19226}, Endpoint{"127.0.0.1", 19227}});
+    client.set_load_balancing(LoadBalancePolicy::RoundRobin);
+    HedgePolicy hedge;
+    hedge.min_delay = std::chrono::milliseconds(30);
+    client.set_hedging(hedge);
+    client.set_idempotent("lookup");
+
+    // 第一份请求轮到慢端点，对冲副本发往快端点并先返回
+    auto start = std::chrono::steady_clock::now();
+    int value = 0;
+    client.async_call("lookup", [&value](const Response& response) {
+        ASSERT_FALSE(response.is_error()) << response.error().message();
+        EXPECT_EQ(response.id().as_int64(), 1);
+        value = static_cast<int>(response.result().as_int64());
+    });
+    client.run();
+    EXPECT_EQ(value, 2);
+
+    // 同步调用同样对冲
+    EXPECT_EQ(client.call<int>("lookup"), 2);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1500));
+
+    slow.stop();
+    fast.stop();
+}
+
+TEST(HashRingTest, SpreadsKeysAndMovesFewOnGrowth) {
+    detail::HashRing ring(160);
+    for (std::size_t i = 0; i < 4; ++i) {
+        ring.add("10.0.0." + std::to_string(i) + ":8080", i);
+    }
+    detail::HashRing grown(160);
+    for (std::size_t i = 0; i < 5; ++i) {
+        grown.add("10.0.0." + std::to_string(i) + ":8080", i);
+    }
+
+    std::vector<int> counts(4, 0);
+    int moved = 0;
+    for (int i = 0; i < 10000; ++i) {
+        std::string key = "user:" + std::to_string(i);
+        std::size_t before = ring.locate(key);
+        ++counts[before];
+        std::size_t after = grown.locate(key);
+        if (after != before) {
+            ++moved;
+            EXPECT_EQ(after, 4u);  // 只会移动到新节点
+        }
+    }
+    for (int count : counts) {
+        EXPECT_GT(count, 1500);
+        EXPECT_LT(count, 3500);
+    }
+    EXPECT_GT(moved, 1000);
+    EXPECT_LT(moved, 3000);
+}
+
+TEST(ShardedClientTest, RoutesByKeyAndScattersMultiKeyCalls) {
+    std::vector<std::unique_ptr<Server>> servers;
+    std::vector<Endpoint> endpoints;
+    for (int i = 0; i < 3; ++i) {
+        unsigned short port = static_cast<unsigned short>(19228 + i);
+        servers.emplace_back(new Server(port, "127.0.0.1"));
+        servers.back()->register_method("owner", [i](const std::string&) { return i; });
+        servers.back()->register_method("put", [i](int, const std::string&) { return i; });
+        servers.back()->register_method("get_many", [i](const std::vector<std::string>& keys) {
+            std::vector<std::string> values;
+            for (const auto& key : keys) {
+                values.push_back(key + "@" + std::to_string(i));
+            }
+            return values;
+        });
+        servers.back()->start();
+        endpoints.push_back(Endpoint{"127.0.0.1", port});
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    ShardedClient client(endpoints);
+    ASSERT_EQ(client.shard_count(), 3u);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 30; ++i) {
+        std::string key = "k" + std::to_string(i);
+        keys.push_back(key);
+        EXPECT_EQ(client.call<int>("owner", key), static_cast<int>(client.shard_for(key)));
+    }
+
+    // 自定义键提取：按第二个参数路由
+    client.set_key_extractor("put", ShardedClient::positional_key(1));
+    EXPECT_EQ(client.call<int>("put", 5, std::string("k7")), static_cast<int>(client.shard_for("k7")));
+    EXPECT_THROW(client.call<int>("owner"), std::invalid_argument);
+
+    std::vector<std::string> values = client.scatter_gather<std::string>("get_many", keys);
+    ASSERT_EQ(values.size(), keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(values[i], keys[i] + "@" + std::to_string(client.shard_for(keys[i])));
+    }
+
+    // 任一分片失败时整体报错
+    EXPECT_THROW(client.scatter_gather<std::string>("missing", keys), Error);
+
+    for (auto& server : servers) {
+        server->stop();
+    }
+}
+
+TEST(ConcurrencyLimiterTest, QueuesRejectsAndAdapts) {
+    detail::ConcurrencyLimiter limiter;
+    ConcurrencyLimitPolicy policy;
+    policy.algorithm = LimitAlgorithm::Aimd;
+    policy.initial_limit = 2;
+    policy.max_queue = 1;
+    policy.backoff_ratio = 0.5;
+    limiter.configure(policy, std::chrono::seconds(10));
+
+    std::vector<int> outcomes;  // 1 放行，0 拒绝
+    for (int i = 0; i < 4; ++i) {
+        limiter.acquire([&outcomes](bool granted) { outcomes.push_back(granted ? 1 : 0); });
+    }
+    EXPECT_EQ(outcomes, (std::vector<int>{1, 1, 0}));
+    EXPECT_EQ(limiter.queued(), 1u);
+
+    // 归还一个名额后放行排队的调用
+    limiter.release(false, std::chrono::milliseconds(1));
+    EXPECT_EQ(outcomes, (std::vector<int>{1, 1, 0, 1}));
+
+    // 网络错误收缩上限，持续成功逐步放大
+    limiter.release(true, std::chrono::milliseconds(1));
+    limiter.release(true, std::chrono::milliseconds(1));
+    EXPECT_EQ(limiter.limit(), 1u);
+    for (int i = 0; i < 20; ++i) {
+        limiter.acquire([](bool) {});
+        limiter.release(false, std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(limiter.limit(), 2u);
+
+    // Gradient：延迟明显上升时收缩
+    policy.algorithm = LimitAlgorithm::Gradient;
+    policy.initial_limit = 50;
+    limiter.configure(policy, std::chrono::seconds(10));
+    for (int i = 0; i < 50; ++i) {
+        limiter.acquire([](bool) {});
+    }
+    for (int i = 0; i < 10; ++i) {
+        limiter.release(false, std::chrono::milliseconds(1));
+        limiter.acquire([](bool) {});
+    }
+    std::size_t before = limiter.limit();
+    for (int i = 0; i < 10; ++i) {
+        limiter.release(false, std::chrono::milliseconds(20));
+        limiter.acquire([](bool) {});
+    }
+    EXPECT_LT(limiter.limit(), before);
+}
+
+TEST_F(JsonRpcServerFixture, ConcurrencyLimitRejectsFast) {
+    Client client("127.0.0.1", 19090);
+    ConcurrencyLimitPolicy policy;
+    policy.initial_limit = 2;
+    policy.min_limit = 2;
+    policy.max_limit = 2;
+    client.set_concurrency_limit(policy);
+
+    int succeeded = 0;
+    int rejected = 0;
+    for (int i = 0; i < 5; ++i) {
+        client.async_call("delay", [&succeeded, &rejected](const Response& response) {
+            if (!response.is_error()) {
+                ++succeeded;
+            } else if (response.error().code() == ErrorCode::Overloaded) {
+                ++rejected;
+            }
+        }, 50);
+    }
+    EXPECT_EQ(client.endpoint_status()[0].outstanding, 2u);
+    client.run();
+    EXPECT_EQ(succeeded, 2);
+    EXPECT_EQ(rejected, 3);
+    EXPECT_EQ(client.endpoint_status()[0].concurrency_limit, 2u);
+
+    // 名额归还后同步调用正常进行
+    EXPECT_EQ(client.call<int>("add", 1, 2), 3);
+}
+
+TEST_F(JsonRpcServerFixture, ShorterDeadlineRearmsPipelineTimer) {
+    boost::asio::io_context io;
+    auto session = std::make_shared<detail::FramedClientSession>(
+        io, "127.0.0.1", "19090", std::chrono::seconds(2), nullptr, Transport::Http);
+
+    // 先发出的调用截止时间更晚，之后超时更短的调用不能等到它的定时器才超时
+    bool slow_ok = false;
+    bool fast_failed = false;
+    std::chrono::steady_clock::duration fast_elapsed{};
+    auto begin = std::chrono::steady_clock::now();
+    session->async_call(Request("delay", boost::json::array{800}, boost::json::value(1)),
+        std::chrono::seconds(2), [&slow_ok](const Response& response) {
+            slow_ok = !response.is_error();
+        });
+    session->async_call(Request("add", boost::json::array{1, 2}, boost::json::value(2)),
+        std::chrono::milliseconds(100), [&](const Response& response) {
+            fast_failed = response.is_error();
+            fast_elapsed = std::chrono::steady_clock::now() - begin;
+        });
+    io.run();
+
+    EXPECT_TRUE(slow_ok);
+    EXPECT_TRUE(fast_failed);
+    EXPECT_LT(fast_elapsed, std::chrono::milliseconds(600));
+}
+
+TEST_F(JsonRpcServerFixture, LoweredTimeoutAppliesToPipelinedCalls) {
+    Client client("127.0.0.1", 19090);
+    client.set_pipelining(true);
+
+    // 调低超时后新的调用按新超时失败，不受已在途调用的定时器影响
+    bool failed = false;
+    client.async_call("delay", [](const Response&) {}, 800);
+    client.set_timeout(std::chrono::milliseconds(100));
+    auto begin = std::chrono::steady_clock::now();
+    client.async_call("delay", [&failed](const Response& response) {
+        failed = response.is_error();
+    }, 500);
+    client.run_for(std::chrono::milliseconds(400));
+    EXPECT_TRUE(failed);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(450));
+    client.run();
+}
+
+TEST_F(JsonRpcServerFixture, PipelinedNotificationResponseIsRead) {
+    boost::asio::io_context io;
+    auto session = std::make_shared<detail::FramedClientSession>(
+        io, "127.0.0.1", "19090", std::chrono::seconds(2), nullptr, Transport::Http);
+
+    // 通知的 204 在通知执行后写回；run() 返回时它应已被读走，而不是留在套接字中
+    session->async_notify(Request("notify_handler", boost::json::array{}));
+    io.run();
+    EXPECT_EQ(notify_counter_->load(), 1);
+
+    int sum = 0;
+    session->async_call(Request("add", boost::json::array{20, 22}, boost::json::value(1)),
+        std::chrono::seconds(2), [&sum](const Response& response) {
+            sum = static_cast<int>(response.result().as_int64());
+        });
+    io.restart();
+    io.run();
+    EXPECT_EQ(sum, 42);
+}
+
+TEST_F(JsonRpcServerFixture, SyncCallDrivesLoopWhileWaitingForSlot) {
+    Client client("127.0.0.1", 19090);
+    client.set_timeout(std::chrono::seconds(2));
+    ConcurrencyLimitPolicy policy;
+    policy.initial_limit = 1;
+    policy.min_limit = 1;
+    policy.max_limit = 1;
+    client.set_concurrency_limit(policy);
+
+    // 唯一的名额被异步调用占用，只有运行事件循环才能归还；同步调用等待时应自行驱动事件循环
+    bool async_done = false;
+    client.async_call("delay", [&async_done](const Response& response) {
+        async_done = !response.is_error();
+    }, 100);
+
+    auto begin = std::chrono::steady_clock::now();
+    EXPECT_EQ(client.call<int>("add", 1, 2), 3);
+    EXPECT_TRUE(async_done);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(1));
+}
+
+TEST(ConcurrencyLimiterTest, RejectsWaitersWhenMaxWaitElapses) {
+    boost::asio::io_context io;
+    detail::ConcurrencyLimiter limiter(io.get_executor());
+    ConcurrencyLimitPolicy policy;
+    policy.max_queue = 4;
+    policy.initial_limit = 1;
+    policy.min_limit = 1;
+    policy.max_limit = 1;
+    limiter.configure(policy, std::chrono::milliseconds(100));
+
+    // 在途调用一直不完成，排队的调用也要在 max_wait 到期时被拒绝
+    std::vector<int> outcomes;
+    limiter.acquire([&outcomes](bool granted) { outcomes.push_back(granted ? 1 : 0); });
+    limiter.acquire([&outcomes](bool granted) { outcomes.push_back(granted ? 1 : 0); });
+    EXPECT_EQ(limiter.queued(), 1u);
+
+    auto begin = std::chrono::steady_clock::now();
+    io.run();
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    EXPECT_EQ(outcomes, (std::vector<int>{1, 0}));
+    EXPECT_EQ(limiter.queued(), 0u);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(80));
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+}
+
+TEST_F(JsonRpcServerFixture, CallsWithPreparedParams) {
+    Client client("127.0.0.1", 19090);
+    client.set_io_threads(1);
+
+    Response sum = client.call_params("add", boost::json::array{2, 3});
+    ASSERT_FALSE(sum.is_error());
+    EXPECT_EQ(sum.result().as_int64(), 5);
+
+    // RPC 错误保留在响应中
+    Response failed = client.call_params("throw_error", boost::json::array{});
+    ASSERT_TRUE(failed.is_error());
+
+    std::promise<Response> product;
+    client.async_call_params("multiply", boost::json::array{4, 5}, [&product](const Response& response) {
+        product.set_value(response);
+    });
+    std::future<Response> future = product.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(future.get().result().as_int64(), 20);
+}
+
+TEST(ClientTest, RetryFromFailureCallbackUsesNewConnection) {
+    Server server(19234, "127.0.0.1");
+    server.set_transport(Transport::LengthPrefixed);
+    server.register_method("add", [](int a, int b) { return a + b; });
+    server.register_method("length", [](const std::string& text) { return text.size(); });
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    boost::asio::io_context io;
+    auto session = std::make_shared<detail::FramedClientSession>(
+        io, "127.0.0.1", "19234", std::chrono::seconds(2), nullptr, Transport::LengthPrefixed);
+
+    // 超过帧长上限的请求使服务端关闭连接，写与读都以错误完成；
+    // 失败回调中重发的调用走新连接，不能被旧连接上迟到的完成回调打断
+    std::string huge(detail::FrameCodec::max_frame_size + 1024, 'x');
+    int failures = 0;
+    int sum = 0;
+    std::string retry_error;
+    session->async_call(Request("length", boost::json::array{huge}, boost::json::value(1)),
+        std::chrono::seconds(2), [&](const Response& response) {
+            if (!response.is_error()) {
+                return;
+            }
+            ++failures;
+            session->async_call(Request("add", boost::json::array{20, 22}, boost::json::value(2)),
+                std::chrono::seconds(2), [&](const Response& retry) {
+                    if (retry.is_error()) {
+                        retry_error = retry.error().message();
+                    } else {
+                        sum = static_cast<int>(retry.result().as_int64());
+                    }
+                });
+        });
+    io.run();
+
+    EXPECT_EQ(failures, 1);
+    EXPECT_EQ(retry_error, "");
+    EXPECT_EQ(sum, 42);
+
+    server.stop();
+}
+
+TEST(ClientLoadBalancingTest, NotificationsDoNotTouchEndpointStats) {
+    Server live(19235, "127.0.0.1");
+    live.register_method("whoami", []() { return 1; });
+    live.register_method("log", [](int) {});
+    live.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 19236 上没有服务端
+    Client client({Endpoint{"127.0.0.1", 19235}, Endpoint{"127.0.0.1", 19236}});
+    client.set_load_balancing(LoadBalancePolicy::RoundRobin);
+    client.set_outlier_ejection(3, std::chrono::seconds(60));
+    client.set_timeout(std::chrono::milliseconds(500));
+
+    int failures = 0;
+    for (int i = 0; i < 2; ++i) {
+        try {
+            client.call<int>("whoami");
+        } catch (const Error&) {
+            ++failures;
+        }
+    }
+    EXPECT_EQ(failures, 1);
+    auto before = client.endpoint_status();
+
+    // 通知没有响应，不能当作零延迟的成功调用
+    for (int i = 0; i < 4; ++i) {
+        client.notify("log", i);
+    }
+    client.flush_notifications();
+
+    auto after = client.endpoint_status();
+    ASSERT_EQ(after.size(), 2u);
+    for (std::size_t i = 0; i < after.size(); ++i) {
+        EXPECT_EQ(after[i].latency, before[i].latency);
+        EXPECT_EQ(after[i].consecutive_failures, before[i].consecutive_failures);
+        EXPECT_EQ(after[i].outstanding, 0u);
+    }
+    EXPECT_EQ(after[1].consecutive_failures, 1u);
+
+    live.stop();
+}
@@ -1,4 +1,6 @@
 #include <jsonrpc/detail/protocol.hpp>
+#include <jsonrpc/detail/request_arena.hpp>
+#include <jsonrpc/detail/frame_codec.hpp>
 #include <gtest/gtest.h>
 
 using namespace jsonrpc::detail;
@@ -271,3 +273,139 @@ TEST(ProtocolTest, IsBatchRequest) {
     auto single_value = boost::json::parse(single_json);
     EXPECT_FALSE(Protocol::is_batch_request(single_value));
 }
+
+TEST(ProtocolTest, ParseAndSerializeWithRequestArena) {
+    RequestArena arena;
+    std::string large(8192, 'x');  // 超出初始缓冲区，验证增长与重置
+
+    for (int round = 0; round < 3; ++round) {
+        std::string payload = R"([{"jsonrpc":"2.0","method":"echo","params":[")" + large +
+            R"("],"id":"a"},{"jsonrpc":"2.0","method":"add","params":[1,2],"id":2}])";
+        {
+            auto requests = Protocol::parse_request(payload, arena.storage());
+            ASSERT_EQ(requests.size(), 2u);
+            EXPECT_EQ(requests[0].params().as_array()[0].as_string().size(), large.size());
+            EXPECT_EQ(requests[0].id().as_string(), "a");
+            EXPECT_EQ(requests[1].params().as_array()[1].as_int64(), 2);
+
+            std::vector<Response> responses;
+            responses.emplace_back(boost::json::value(3), requests[1].id());
+            std::string body = Protocol::serialize_batch_response(responses, arena.storage());
+            auto parsed = boost::json::parse(body);
+            EXPECT_EQ(parsed.as_array()[0].as_object().at("result").as_int64(), 3);
+        }
+        arena.reset();
+    }
+}
+
+TEST(ProtocolTest, ParseRequestsReportsBatchFlag) {
+    auto single = Protocol::parse_requests(R"({"jsonrpc":"2.0","method":"ping","id":1})");
+    EXPECT_FALSE(single.is_batch);
+    ASSERT_EQ(single.requests.size(), 1u);
+
+    // 只有一个元素的数组仍是批量请求
+    auto batch = Protocol::parse_requests(R"([{"jsonrpc":"2.0","method":"ping","id":1}])");
+    EXPECT_TRUE(batch.is_batch);
+    ASSERT_EQ(batch.requests.size(), 1u);
+    EXPECT_EQ(batch.requests[0].method(), "ping");
+
+    EXPECT_THROW(Protocol::parse_requests("[]"), Error);
+}
+
+TEST(ProtocolTest, WriteResponseMatchesSerialize) {
+    boost::json::object payload;
+    payload["items"] = boost::json::array{1, "two", nullptr, 3.5};
+    payload["text"] = std::string(10000, 'q');  // 超过单次分块大小
+
+    std::vector<Response> responses;
+    responses.emplace_back(boost::json::value(payload), boost::json::value("req-1"));
+    responses.emplace_back(Error(ErrorCode::InvalidParams, "bad \"quote\"", boost::json::value(boost::json::array{1, 2})),
+                           boost::json::value(2));
+    responses.emplace_back(Error(ErrorCode::MethodNotFound, "missing"), boost::json::value(nullptr));
+
+    for (const auto& response : responses) {
+        std::string out = "prefix";
+        Protocol::write_response(response, out);
+        EXPECT_EQ(boost::json::parse(out.substr(6)), boost::json::parse(Protocol::serialize_response(response)));
+    }
+
+    std::string batch;
+    Protocol::write_batch_response(responses, batch);
+    EXPECT_EQ(boost::json::parse(batch), boost::json::parse(Protocol::serialize_batch_response(responses)));
+
+    std::string empty;
+    Protocol::write_batch_response({}, empty);
+    EXPECT_EQ(empty, "[]");
+}
+
+TEST(ProtocolTest, FrameCodecRoundTrip) {
+    for (Transport transport : {Transport::LengthPrefixed, Transport::NewlineDelimited}) {
+        std::string stream;
+        for (const char* payload : {R"({"a":1})", R"([1,2,3])"}) {
+            std::size_t start = FrameCodec::begin_frame(transport, stream);
+            stream.append(payload);
+            FrameCodec::end_frame(transport, stream, start);
+        }
+
+        // 不完整的帧
+        EXPECT_EQ(FrameCodec::decode(transport, stream.data(), 3).status, FrameCodec::Status::NeedMore);
+
+        FrameCodec::Decoded first = FrameCodec::decode(transport, stream.data(), stream.size());
+        ASSERT_EQ(first.status, FrameCodec::Status::Complete);
+        EXPECT_EQ(stream.substr(first.payload_offset, first.payload_size), R"({"a":1})");
+
+        const char* rest = stream.data() + first.consumed;
+        FrameCodec::Decoded second = FrameCodec::decode(transport, rest, stream.size() - first.consumed);
+        ASSERT_EQ(second.status, FrameCodec::Status::Complete);
+        EXPECT_EQ(std::string(rest + second.payload_offset, second.payload_size), "[1,2,3]");
+        EXPECT_EQ(first.consumed + second.consumed, stream.size());
+    }
+
+    // NDJSON 兼容 CRLF
+    std::string line = "{}\r\n";
+    FrameCodec::Decoded crlf = FrameCodec::decode(Transport::NewlineDelimited, line.data(), line.size());
+    ASSERT_EQ(crlf.status, FrameCodec::Status::Complete);
+    EXPECT_EQ(crlf.payload_size, 2u);
+    EXPECT_EQ(crlf.consumed, 4u);
+
+    // 超过上限的长度前缀
+    const char header[] = { '\x7f', '\x00', '\x00', '\x00' };
+    EXPECT_EQ(FrameCodec::decode(Transport::LengthPrefixed, header, 4).status, FrameCodec::Status::TooLarge);
+}
+
+TEST(ProtocolTest, FrameHeaderCarriesTimeout) {
+    for (Transport transport : {Transport::LengthPrefixed, Transport::NewlineDelimited}) {
+        std::string stream;
+        std::size_t start = FrameCodec::begin_frame(transport, stream, std::chrono::milliseconds(250));
+        stream.append(R"({"a":1})");
+        FrameCodec::end_frame(transport, stream, start);
+        start = FrameCodec::begin_frame(transport, stream);
+        stream.append("[]");
+        FrameCodec::end_frame(transport, stream, start);
+
+        // 帧头不完整时等待更多数据
+        EXPECT_EQ(FrameCodec::decode(transport, stream.data(), 6).status, FrameCodec::Status::NeedMore);
+
+        FrameCodec::Decoded first = FrameCodec::decode(transport, stream.data(), stream.size());
+        ASSERT_EQ(first.status, FrameCodec::Status::Complete);
+        EXPECT_EQ(first.timeout_ms, 250u);
+        EXPECT_EQ(stream.substr(first.payload_offset, first.payload_size), R"({"a":1})");
+
+        const char* rest = stream.data() + first.consumed;
+        FrameCodec::Decoded second = FrameCodec::decode(transport, rest, stream.size() - first.consumed);
+        ASSERT_EQ(second.status, FrameCodec::Status::Complete);
+        EXPECT_EQ(second.timeout_ms, 0u);
+        EXPECT_EQ(std::string(rest + second.payload_offset, second.payload_size), "[]");
+    }
+
+    // 格式不对的 NDJSON 帧头整行作为负载，由 JSON 解析报错
+    std::string line = "@abc {}\n";
+    FrameCodec::Decoded bad = FrameCodec::decode(Transport::NewlineDelimited, line.data(), line.size());
+    ASSERT_EQ(bad.status, FrameCodec::Status::Complete);
+    EXPECT_EQ(bad.timeout_ms, 0u);
+    EXPECT_EQ(bad.payload_size, 7u);
+
+    // 请求本身保持标准 JSON-RPC 格式
+    Request call("add", boost::json::array{1, 2}, boost::json::value(1));
+    EXPECT_EQ(boost::json::parse(Protocol::serialize_request(call)).as_object().size(), 4u);
+}
@@ -1,13 +1,22 @@
+#include <jsonrpc/detail/frame_codec.hpp>
 #include <jsonrpc/detail/method_registry.hpp>
+#include <jsonrpc/detail/protocol.hpp>
 #include <jsonrpc/server.hpp>
 #include <jsonrpc/client.hpp>
 #include <jsonrpc/types.hpp>
 #include <gtest/gtest.h>
 #include <boost/asio.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http.hpp>
 #include <chrono>
+#include <cstdio>
 #include <thread>
 #include <atomic>
 #include <vector>
+#include <future>
+#include <mutex>
+#include <memory>
+#include <algorithm>
 
 using namespace jsonrpc;
 using namespace jsonrpc::detail;
@@ -380,3 +389,879 @@ TEST(ServerApiTest, KeepAlive) {
 
     server.stop();
 }
+
+// ============================================================================
+// 分组 4：多线程 I/O
+// ============================================================================
+
+TEST(ServerApiTest, SetIoThreadsRequiresStoppedServer) {
+    Server server(19210, "127.0.0.1");
+    EXPECT_EQ(server.io_threads(), 1u);
+    server.set_io_threads(0);
+    EXPECT_EQ(server.io_threads(), 1u);
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_THROW(server.set_io_threads(4), std::logic_error);
+    server.stop();
+
+    EXPECT_NO_THROW(server.set_io_threads(4));
+    EXPECT_EQ(server.io_threads(), 4u);
+}
+
+TEST(ServerApiTest, MultiThreadedIoServesConnectionsInParallel) {
+    Server server(19211, "127.0.0.1");
+    server.set_io_threads(4);
+    server.register_method("delay", [](int millis) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+        return millis;
+    });
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    std::atomic<int> succeeded{0};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&succeeded]() {
+            Client client("127.0.0.1", 19211);
+            if (client.call<int>("delay", 300) == 300) {
+                ++succeeded;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(succeeded.load(), 4);
+    // 单 I/O 线程时四个连接会串行（约 1200ms）
+    EXPECT_LT(elapsed, std::chrono::milliseconds(900));
+
+    server.stop();
+}
+
+TEST(ServerTest, ReadOnlyRegistryRejectsRegistration) {
+    MethodRegistry registry;
+    registry.register_method("add", [](int a, int b) { return a + b; });
+    registry.set_read_only(true);
+
+    EXPECT_THROW(registry.register_method("sub", [](int a, int b) { return a - b; }), std::logic_error);
+
+    Request request("add", boost::json::array{2, 3}, boost::json::value(1));
+    auto response = registry.invoke(request);
+    ASSERT_FALSE(response.is_error());
+    EXPECT_EQ(response.result().as_int64(), 5);
+
+    registry.set_read_only(false);
+    EXPECT_NO_THROW(registry.register_method("sub", [](int a, int b) { return a - b; }));
+}
+
+TEST(ServerApiTest, PerCoreAcceptorsShareRegistry) {
+    Server server(19212, "127.0.0.1");
+    server.set_io_threads(3);
+    server.set_per_core_acceptors(true);
+    EXPECT_TRUE(server.per_core_acceptors());
+    server.register_method("add", [](int a, int b) { return a + b; });
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_THROW(server.register_method("late", []() { return 1; }), std::logic_error);
+    EXPECT_THROW(server.set_per_core_acceptors(false), std::logic_error);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> succeeded{0};
+    for (int i = 0; i < 6; ++i) {
+        threads.emplace_back([&succeeded, i]() {
+            Client client("127.0.0.1", 19212);
+            if (client.call<int>("add", i, 1) == i + 1) {
+                ++succeeded;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(succeeded.load(), 6);
+
+    server.stop();
+    EXPECT_NO_THROW(server.register_method("late", []() { return 1; }));
+
+    // 重新启动后仍可服务
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Client client("127.0.0.1", 19212);
+    EXPECT_EQ(client.call<int>("late"), 1);
+    server.stop();
+}
+
+TEST(ServerTest, AsyncInvokeBatchPreservesOrder) {
+    MethodRegistry registry;
+    registry.register_method("delay_echo", [](int value) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10 * (5 - value)));
+        return value;
+    });
+
+    std::vector<Request> requests;
+    for (int i = 0; i < 5; ++i) {
+        requests.emplace_back("delay_echo", boost::json::array{i}, boost::json::value(i));
+    }
+    requests.emplace_back("delay_echo", boost::json::array{0});  // notification
+
+    std::promise<std::vector<Response>> promise;
+    auto future = promise.get_future();
+    registry.async_invoke_batch(requests, [&promise](std::vector<Response> responses) {
+        promise.set_value(std::move(responses));
+    });
+
+    auto responses = future.get();
+    ASSERT_EQ(responses.size(), 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(responses[i].id().as_int64(), i);
+        EXPECT_EQ(responses[i].result().as_int64(), i);
+    }
+}
+
+TEST(ServerApiTest, SlowHandlerDoesNotBlockOtherConnections) {
+    // 单 I/O 线程：慢调用执行期间其他连接仍应得到及时响应
+    Server server(19213, "127.0.0.1");
+    server.register_method("delay", [](int millis) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+        return millis;
+    });
+    server.register_method("add", [](int a, int b) { return a + b; });
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::thread slow([]() {
+        Client client("127.0.0.1", 19213);
+        EXPECT_EQ(client.call<int>("delay", 800), 800);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto begin = std::chrono::steady_clock::now();
+    Client client("127.0.0.1", 19213);
+    EXPECT_EQ(client.call<int>("add", 1, 2), 3);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(400));
+
+    slow.join();
+    server.stop();
+}
+
+TEST(ServerTest, AsyncInvokeSingleRequest) {
+    MethodRegistry registry;
+    registry.register_method("add", [](int a, int b) { return a + b; });
+
+    Request request("add", boost::json::array{4, 5}, boost::json::value(7));
+    std::promise<Response> promise;
+    auto future = promise.get_future();
+    registry.async_invoke(request, [&promise](Response response) {
+        promise.set_value(std::move(response));
+    });
+
+    Response response = future.get();
+    ASSERT_FALSE(response.is_error());
+    EXPECT_EQ(response.result().as_int64(), 9);
+    EXPECT_EQ(response.id().as_int64(), 7);
+}
+
+TEST(ServerApiTest, SingleRequestDispatchModes) {
+    Server server(19214, "127.0.0.1");
+    EXPECT_EQ(server.single_request_dispatch(), SingleRequestDispatch::Pooled);
+
+    boost::asio::io_context& io = server.get_io_context();
+    server.register_method("on_io_thread", [&io]() {
+        return io.get_executor().running_in_this_thread();
+    });
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_THROW(server.set_single_request_dispatch(SingleRequestDispatch::Inline), std::logic_error);
+    {
+        Client client("127.0.0.1", 19214);
+        EXPECT_FALSE(client.call<bool>("on_io_thread"));
+    }
+    server.stop();
+
+    server.set_single_request_dispatch(SingleRequestDispatch::Inline);
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        Client client("127.0.0.1", 19214);
+        EXPECT_TRUE(client.call<bool>("on_io_thread"));
+    }
+    server.stop();
+}
+
+TEST(ServerTest, AsyncMethodRepliesFromAnotherThread) {
+    MethodRegistry registry;
+    registry.register_async_method("delayed_add", [](int a, int b, Responder<int> responder) {
+        std::thread([a, b, responder]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            responder.reply(a + b);
+        }).detach();
+    });
+    registry.register_async_method("fail", [](Responder<void> responder) {
+        responder.reply_error(Error(ErrorCode::ServerError, "boom"));
+        EXPECT_THROW(responder.reply(), std::logic_error);
+    });
+    registry.register_async_method("forget", [](Responder<int>) {});
+
+    Response sum = registry.invoke(Request("delayed_add", boost::json::array{2, 3}, boost::json::value(1)));
+    ASSERT_FALSE(sum.is_error());
+    EXPECT_EQ(sum.result().as_int64(), 5);
+
+    Response failed = registry.invoke(Request("fail", nullptr, boost::json::value(2)));
+    ASSERT_TRUE(failed.is_error());
+    EXPECT_EQ(failed.error().code(), ErrorCode::ServerError);
+
+    Response forgotten = registry.invoke(Request("forget", nullptr, boost::json::value(3)));
+    ASSERT_TRUE(forgotten.is_error());
+    EXPECT_EQ(forgotten.error().code(), ErrorCode::InternalError);
+
+    Response bad_params = registry.invoke(Request("delayed_add", boost::json::array{1}, boost::json::value(4)));
+    ASSERT_TRUE(bad_params.is_error());
+    EXPECT_EQ(bad_params.error().code(), ErrorCode::InvalidParams);
+}
+
+TEST(ServerApiTest, AsyncMethodsDoNotHoldWorkerThreads) {
+    Server server(19215, "127.0.0.1");
+    server.set_batch_concurrency(1);
+
+    std::mutex mutex;
+    std::vector<Responder<int>> pending;
+    server.register_async_method("park", [&](int, Responder<int> responder) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(responder);
+        if (pending.size() == 4) {
+            // 最后一个到达后统一回复，说明唯一的工作线程没有被前面的调用占住
+            for (std::size_t i = 0; i < pending.size(); ++i) {
+                pending[i].reply(static_cast<int>(i));
+            }
+            pending.clear();
+        }
+    });
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 4; ++i) {
+        results.push_back(std::async(std::launch::async, [i]() {
+            Client client("127.0.0.1", 19215);
+            return client.call<int>("park", i);
+        }));
+    }
+    for (auto& result : results) {
+        ASSERT_EQ(result.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        EXPECT_GE(result.get(), 0);
+    }
+
+    server.stop();
+}
+
+TEST(ServerApiTest, RawTcpTransports) {
+    Transport transports[] = { Transport::LengthPrefixed, Transport::NewlineDelimited };
+    for (Transport transport : transports) {
+        Server server(19217, "127.0.0.1");
+        server.set_transport(transport);
+        EXPECT_EQ(server.transport(), transport);
+
+        // 先到的请求后完成，响应在同一连接上乱序返回
+        server.register_method("sleep_echo", [](int ms, int value) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+            return value;
+        });
+        std::atomic<int> notified(0);
+        server.register_method("touch", [&notified]() { ++notified; });
+
+        server.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_THROW(server.set_transport(Transport::Http), std::logic_error);
+
+        Client client("127.0.0.1", 19217);
+        client.set_transport(transport);
+        EXPECT_EQ(client.call<int>("sleep_echo", 0, 7), 7);
+
+        std::vector<Request> batch;
+        batch.push_back(Request("sleep_echo", boost::json::value(boost::json::array{0, 1}), boost::json::value(100)));
+        batch.push_back(Request("sleep_echo", boost::json::value(boost::json::array{0, 2}), boost::json::value(101)));
+        auto batch_responses = client.call_batch(batch);
+        ASSERT_EQ(batch_responses.size(), 2u);
+        EXPECT_EQ(batch_responses[1].result().as_int64(), 2);
+
+        client.notify("touch");
+
+        std::vector<int> completed;
+        const int count = 16;
+        for (int i = 0; i < count; ++i) {
+            client.async_call("sleep_echo", [&completed](const Response& response) {
+                ASSERT_FALSE(response.is_error()) << response.error().message();
+                completed.push_back(static_cast<int>(response.result().as_int64()));
+            }, (count - i) * 5, i);
+        }
+        client.run();
+
+        ASSERT_EQ(completed.size(), static_cast<std::size_t>(count));
+        std::vector<int> sorted = completed;
+        std::sort(sorted.begin(), sorted.end());
+        for (int i = 0; i < count; ++i) {
+            EXPECT_EQ(sorted[i], i);
+        }
+        EXPECT_NE(completed, sorted);
+
+        for (int i = 0; i < 50 && notified.load() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_EQ(notified.load(), 1);
+
+        server.stop();
+    }
+}
+
+TEST(ClientTest, RawTcpAsyncCallTimesOut) {
+    Server server(19218, "127.0.0.1");
+    server.set_transport(Transport::LengthPrefixed);
+    server.register_method("slow", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        return 1;
+    });
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Client client("127.0.0.1", 19218);
+    client.set_transport(Transport::LengthPrefixed);
+    client.set_timeout(std::chrono::milliseconds(50));
+
+    bool failed = false;
+    client.async_call("slow", [&failed](const Response& response) {
+        failed = response.is_error();
+    });
+    client.run();
+    EXPECT_TRUE(failed);
+
+    server.stop();
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+TEST(ServerApiTest, UnixSocketListenerAlongsideTcp) {
+    const std::string path = "/tmp/jsonrpc_test_19219.sock";
+    const std::string endpoint = "unix:" + path;
+
+    Transport transports[] = { Transport::Http, Transport::LengthPrefixed };
+    for (Transport transport : transports) {
+        Server server(19219, "127.0.0.1");
+        server.set_transport(transport);
+        server.listen_unix(path);
+        server.register_method("add", [](int a, int b) { return a + b; });
+
+        server.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_THROW(server.listen_unix(path + ".2"), std::logic_error);
+
+        Client tcp_client("127.0.0.1", 19219);
+        tcp_client.set_transport(transport);
+        EXPECT_EQ(tcp_client.call<int>("add", 1, 2), 3);
+
+        Client unix_client(endpoint, 0);
+        unix_client.set_transport(transport);
+        EXPECT_EQ(unix_client.call<int>("add", 3, 4), 7);
+
+        int async_result = 0;
+        unix_client.async_call("add", [&async_result](const Response& response) {
+            ASSERT_FALSE(response.is_error()) << response.error().message();
+            async_result = static_cast<int>(response.result().as_int64());
+        }, 5, 6);
+        unix_client.run();
+        EXPECT_EQ(async_result, 11);
+
+        server.stop();
+    }
+
+    // 停止后删除套接字文件
+    Client client(endpoint, 0);
+    client.set_timeout(std::chrono::milliseconds(500));
+    EXPECT_THROW(client.call<int>("add", 1, 2), Error);
+}
+
+TEST(ServerApiTest, UnixSocketPathInUseIsNotTakenOver) {
+    const std::string path = "/tmp/jsonrpc_test_19237.sock";
+    std::remove(path.c_str());
+
+    // 普通文件不会被删除
+    {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        std::fclose(file);
+        Server server(19237, "127.0.0.1");
+        server.listen_unix(path);
+        EXPECT_THROW(server.start(), boost::system::system_error);
+        EXPECT_EQ(std::remove(path.c_str()), 0);
+    }
+
+    Server first(19237, "127.0.0.1");
+    first.listen_unix(path);
+    first.register_method("whoami", []() { return 1; });
+    first.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 另一个服务器正在监听的路径不会被接管
+    {
+        Server second(19238, "127.0.0.1");
+        second.listen_unix(path);
+        EXPECT_THROW(second.start(), boost::system::system_error);
+    }
+    Client client("unix:" + path, 0);
+    EXPECT_EQ(client.call<int>("whoami"), 1);
+    first.stop();
+
+    // 无人监听的残留套接字文件照常清理
+    {
+        boost::asio::io_context io;
+        boost::asio::local::stream_protocol::acceptor stale(io, boost::asio::local::stream_protocol::endpoint(path));
+    }
+    Server restarted(19238, "127.0.0.1");
+    restarted.listen_unix(path);
+    restarted.register_method("whoami", []() { return 2; });
+    restarted.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Client stale_client("unix:" + path, 0);
+    EXPECT_EQ(stale_client.call<int>("whoami"), 2);
+    restarted.stop();
+}
+#endif
+
+#ifdef JSONRPC_HAS_COROUTINES
+TEST(ServerApiTest, CoroutineMethodsAwaitWithoutBlocking) {
+    Server server(19216, "127.0.0.1");
+    server.set_single_request_dispatch(SingleRequestDispatch::Inline);
+
+    server.register_method("sleepy_add", [](int a, int b) -> boost::asio::awaitable<int> {
+        boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor,
+                                        std::chrono::milliseconds(200));
+        co_await timer.async_wait(boost::asio::use_awaitable);
+        co_return a + b;
+    });
+    server.register_method("co_fail", []() -> boost::asio::awaitable<void> {
+        throw Error(ErrorCode::InvalidParams, "bad");
+        co_return;
+    });
+    server.register_method("ping", []() { return std::string("pong"); });
+
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 单个 I/O 线程内联执行：协程挂起期间其他连接仍能得到响应
+    auto slow = std::async(std::launch::async, []() {
+        Client client("127.0.0.1", 19216);
+        return client.call<int>("sleepy_add", 20, 22);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    {
+        Client client("127.0.0.1", 19216);
+        EXPECT_EQ(client.call<std::string>("ping"), "pong");
+        EXPECT_EQ(slow.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+        EXPECT_THROW(client.call<int>("co_fail"), Error);
+    }
+    EXPECT_EQ(slow.get(), 42);
+
+    server.stop();
+}
+
+TEST(ServerTest, CoroutineMethodInvokedDirectly) {
+    MethodRegistry registry;
+    registry.register_method("twice", [](int v) -> boost::asio::awaitable<int> {
+        co_return v * 2;
+    });
+
+    Response response = registry.invoke(Request("twice", boost::json::array{21}, boost::json::value(1)));
+    ASSERT_FALSE(response.is_error());
+    EXPECT_EQ(response.result().as_int64(), 42);
+}
+#endif
+
+TEST(ServerTest, ExpiredRequestsAreNotExecuted) {
+    MethodRegistry registry;
+    std::atomic<int> executed(0);
+    registry.register_method("budget", [&executed](const CallContext& context, int floor) {
+        ++executed;
+        return context.has_deadline() ? std::max<int>(floor, static_cast<int>(context.remaining().count())) : -1;
+    });
+    registry.register_async_method("async_budget", [](const CallContext& context, Responder<bool> responder) {
+        responder.reply(context.has_deadline());
+    });
+
+    Request request("budget", boost::json::array{0}, boost::json::value(1));
+    InvokeContext context;
+
+    // 没有截止时间
+    Response response = registry.invoke(request);
+    ASSERT_FALSE(response.is_error()) << response.error().message();
+    EXPECT_EQ(response.result().as_int64(), -1);
+
+    // 方法可以读取剩余时间
+    context.call = CallContext(CallContext::clock::now() + std::chrono::seconds(10));
+    registry.begin_invoke(request, [&response](Response r) { response = std::move(r); }, context);
+    ASSERT_FALSE(response.is_error());
+    EXPECT_GT(response.result().as_int64(), 5000);
+
+    Request async_request("async_budget", boost::json::array{}, boost::json::value(2));
+    registry.begin_invoke(async_request, [&response](Response r) { response = std::move(r); }, context);
+    ASSERT_FALSE(response.is_error());
+    EXPECT_TRUE(response.result().as_bool());
+
+    // 已过期的请求不执行
+    context.call = CallContext(CallContext::clock::now() - std::chrono::milliseconds(1));
+    registry.begin_invoke(request, [&response](Response r) { response = std::move(r); }, context);
+    ASSERT_TRUE(response.is_error());
+    EXPECT_EQ(response.error().code(), ErrorCode::DeadlineExceeded);
+    EXPECT_EQ(executed.load(), 2);
+}
+
+TEST(ServerApiTest, DropsRequestsQueuedPastClientDeadline) {
+    Transport transports[] = { Transport::Http, Transport::LengthPrefixed };
+    for (Transport transport : transports) {
+        Server server(19229, "127.0.0.1");
+        server.set_transport(transport);
+        server.set_batch_concurrency(1);
+        std::atomic<int> executed(0);
+        server.register_method("slow", [&executed](int millis) {
+            ++executed;
+            std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+            return millis;
+        });
+
+        server.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // 唯一的工作线程被占用 300ms，之后排队的调用等待时间只有 100ms
+        std::thread blocker([transport]() {
+            Client client("127.0.0.1", 19229);
+            client.set_transport(transport);
+            EXPECT_EQ(client.call<int>("slow", 300), 300);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        // 直接发送携带截止时间的请求，连接保持打开，等待服务端的回复
+        std::string body = R"({"jsonrpc":"2.0","method":"slow","params":[0],"id":1})";
+        std::string wire;
+        if (transport == Transport::Http) {
+            wire = "POST / HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\n" +
+                   std::string(timeout_header) + ": 100\r\nContent-Length: " +
+                   std::to_string(body.size()) + "\r\n\r\n" + body;
+        } else {
+            std::size_t frame_start = FrameCodec::begin_frame(transport, wire, std::chrono::milliseconds(100));
+            wire.append(body);
+            FrameCodec::end_frame(transport, wire, frame_start);
+        }
+
+        boost::asio::io_context io;
+        boost::asio::ip::tcp::socket socket(io);
+        socket.connect({boost::asio::ip::make_address("127.0.0.1"), 19229});
+        boost::asio::write(socket, boost::asio::buffer(wire));
+
+        std::string payload;
+        if (transport == Transport::Http) {
+            boost::beast::flat_buffer buffer;
+            boost::beast::http::response<boost::beast::http::string_body> res;
+            boost::beast::http::read(socket, buffer, res);
+            EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+            payload = res.body();
+        } else {
+            std::string received;
+            char chunk[1024];
+            while (true) {
+                received.append(chunk, socket.read_some(boost::asio::buffer(chunk)));
+                FrameCodec::Decoded decoded = FrameCodec::decode(transport, received.data(), received.size());
+                if (decoded.status == FrameCodec::Status::Complete) {
+                    payload = received.substr(decoded.payload_offset, decoded.payload_size);
+                    break;
+                }
+            }
+        }
+
+        Response response = Protocol::parse_response(payload);
+        ASSERT_TRUE(response.is_error());
+        EXPECT_EQ(response.error().code(), ErrorCode::DeadlineExceeded);
+        EXPECT_EQ(response.id().as_int64(), 1);
+
+        blocker.join();
+        EXPECT_EQ(executed.load(), 1);
+
+        server.stop();
+    }
+}
+
+TEST(ServerApiTest, ClientDisconnectCancelsPendingWork) {
+    Transport transports[] = { Transport::Http, Transport::LengthPrefixed };
+    for (Transport transport : transports) {
+        Server server(19230, "127.0.0.1");
+        server.set_transport(transport);
+        server.set_batch_concurrency(1);
+        std::atomic<bool> saw_cancel(false);
+        std::atomic<int> counted(0);
+        server.register_method("spin", [&saw_cancel](const CallContext& context) {
+            auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (!context.cancelled() && std::chrono::steady_clock::now() < give_up) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            saw_cancel = context.cancelled();
+            return 0;
+        });
+        server.register_method("count", [&counted]() { return ++counted; });
+
+        server.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // 唯一的工作线程执行 spin 时，其后的 count 仍在排队
+        std::string body = R"([{"jsonrpc":"2.0","method":"spin","id":1},)"
+                           R"({"jsonrpc":"2.0","method":"count","id":2},)"
+                           R"({"jsonrpc":"2.0","method":"count","id":3}])";
+        std::string wire;
+        if (transport == Transport::Http) {
+            wire = "POST / HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\nContent-Length: " +
+                   std::to_string(body.size()) + "\r\n\r\n" + body;
+        } else {
+            std::size_t frame_start = FrameCodec::begin_frame(transport, wire);
+            wire.append(body);
+            FrameCodec::end_frame(transport, wire, frame_start);
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        {
+            boost::asio::io_context io;
+            boost::asio::ip::tcp::socket socket(io);
+            socket.connect({boost::asio::ip::make_address("127.0.0.1"), 19230});
+            boost::asio::write(socket, boost::asio::buffer(wire));
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        for (int i = 0; i < 100 && !saw_cancel; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_TRUE(saw_cancel);
+        EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(1500));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(counted.load(), 0);
+
+        server.stop();
+    }
+}
+
+TEST(ServerApiTest, DestructorWaitsForOutstandingResponders) {
+    std::unique_ptr<Server> server(new Server(19232, "127.0.0.1"));
+
+    std::promise<Responder<int>> parked;
+    server->register_async_method("park", [&](Responder<int> responder) {
+        parked.set_value(responder);
+    });
+    server->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto call = std::async(std::launch::async, []() {
+        try {
+            Client client("127.0.0.1", 19232);
+            return client.call<int>("park");
+        } catch (const std::exception&) {
+            return -1;  // 服务器已停止，连接可能在回复前关闭
+        }
+    });
+
+    // Responder 由服务器之外的线程持有，析构开始后才回复
+    std::future<Responder<int>> responder_future = parked.get_future();
+    ASSERT_EQ(responder_future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    std::atomic<bool> replied(false);
+    std::thread replier([&replied](Responder<int> responder) mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        replied = true;
+        responder.reply(7);
+    }, responder_future.get());
+
+    server.reset();
+    EXPECT_TRUE(replied.load());
+
+    replier.join();
+    call.get();
+}
+
+TEST(ServerApiTest, DestructorAbandonsRespondersParkedForever) {
+    std::unique_ptr<Server> server(new Server(19239, "127.0.0.1"));
+
+    // 长轮询：Responder 保存在用户自己的状态中，服务器析构前不会回复
+    std::mutex mutex;
+    std::vector<Responder<int>> subscribers;
+    std::promise<void> parked;
+    server->register_async_method("subscribe", [&](Responder<int> responder) {
+        std::lock_guard<std::mutex> lock(mutex);
+        subscribers.push_back(responder);
+        parked.set_value();
+    });
+    server->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto call = std::async(std::launch::async, []() {
+        try {
+            Client client("127.0.0.1", 19239);
+            client.set_timeout(std::chrono::seconds(10));
+            return client.call<int>("subscribe");
+        } catch (const std::exception&) {
+            return -1;
+        }
+    });
+    ASSERT_EQ(parked.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    // 析构限时等待后放弃，连接被关闭
+    auto begin = std::chrono::steady_clock::now();
+    server.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(8));
+    ASSERT_EQ(call.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(call.get(), -1);
+
+    // 服务器销毁后回复与销毁 Responder 都是安全的
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(subscribers.size(), 1u);
+    subscribers[0].reply(1);
+    subscribers.clear();
+}
+
+TEST(ServerTest, ShutdownRegistryRefusesNewCalls) {
+    MethodRegistry registry;
+    std::atomic<int> executed(0);
+    registry.register_method("count", [&executed]() { return ++executed; });
+
+    registry.shutdown();
+    registry.drain();
+
+    // 线程池不会重建，排队路径与直接调用都以错误完成
+    Response queued(boost::json::value(), boost::json::value());
+    registry.async_invoke(Request("count", nullptr, boost::json::value(1)),
+                          [&queued](Response response) { queued = std::move(response); });
+    ASSERT_TRUE(queued.is_error());
+    EXPECT_EQ(queued.error().code(), ErrorCode::ServerError);
+
+    std::vector<Request> batch;
+    batch.emplace_back("count", nullptr, boost::json::value(2));
+    auto responses = registry.invoke_batch(batch);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_TRUE(responses[0].is_error());
+    EXPECT_EQ(executed.load(), 0);
+}
+
+TEST(ServerApiTest, HalfCloseIsTreatedAsDisconnect) {
+    Transport transports[] = { Transport::Http, Transport::LengthPrefixed };
+    for (Transport transport : transports) {
+        Server server(19233, "127.0.0.1");
+        server.set_transport(transport);
+        std::atomic<bool> saw_cancel(false);
+        server.register_method("spin", [&saw_cancel](const CallContext& context) {
+            auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (!context.cancelled() && std::chrono::steady_clock::now() < give_up) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            saw_cancel = context.cancelled();
+            return 0;
+        });
+
+        server.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        std::string body = R"({"jsonrpc":"2.0","method":"spin","id":1})";
+        std::string wire;
+        if (transport == Transport::Http) {
+            wire = "POST / HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\nContent-Length: " +
+                   std::to_string(body.size()) + "\r\n\r\n" + body;
+        } else {
+            std::size_t frame_start = FrameCodec::begin_frame(transport, wire);
+            wire.append(body);
+            FrameCodec::end_frame(transport, wire, frame_start);
+        }
+
+        // 发送后只关闭写方向，仍在等待读取：服务端看到的 FIN 与完全关闭相同
+        boost::asio::io_context io;
+        boost::asio::ip::tcp::socket socket(io);
+        socket.connect({boost::asio::ip::make_address("127.0.0.1"), 19233});
+        boost::asio::write(socket, boost::asio::buffer(wire));
+        socket.shutdown(boost::asio::ip::tcp::socket::shutdown_send);
+
+        std::string received;
+        boost::system::error_code read_error;
+        boost::asio::async_read(socket, boost::asio::dynamic_buffer(received),
+            [&read_error](boost::system::error_code ec, std::size_t) { read_error = ec; });
+        io.run_for(std::chrono::seconds(3));
+
+        EXPECT_TRUE(saw_cancel);
+        EXPECT_EQ(read_error, boost::asio::error::eof);
+        EXPECT_TRUE(received.empty());
+
+        server.stop();
+    }
+}
+
+TEST(ServerTest, PriorityClassesReorderQueuedCalls) {
+    MethodRegistry registry;
+    registry.set_batch_concurrency(1);
+    SchedulingPolicy policy;
+    policy.mode = PriorityScheduling::Strict;
+    registry.set_priority_scheduling(policy);
+    registry.set_method_priority("interactive", Priority::High);
+    registry.set_method_priority("bulk", Priority::Low);
+
+    // 唯一的工作线程先被占住，其余调用都在队列中等待
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    std::mutex mutex;
+    std::string order;
+    registry.register_method("block", [opened]() { opened.wait(); return 0; });
+    registry.register_method("interactive", [&](std::string tag) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order += tag;
+        return 0;
+    });
+    registry.register_method("bulk", [&](std::string tag) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order += tag;
+        return 0;
+    });
+
+    std::vector<Request> requests;
+    requests.emplace_back("block", boost::json::array{}, boost::json::value(0));
+    requests.emplace_back("bulk", boost::json::array{"b"}, boost::json::value(1));
+    requests.emplace_back("bulk", boost::json::array{"b"}, boost::json::value(2));
+    requests.emplace_back("interactive", boost::json::array{"i"}, boost::json::value(3));
+    requests.emplace_back("bulk", boost::json::array{"B"}, boost::json::value(4));
+    requests.emplace_back("interactive", boost::json::array{"i"}, boost::json::value(5));
+
+    std::atomic<int> remaining(static_cast<int>(requests.size()));
+    std::promise<void> done;
+    auto on_response = [&remaining, &done](Response) {
+        if (--remaining == 0) {
+            done.set_value();
+        }
+    };
+
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        InvokeContext context;
+        if (i == 4) {
+            // 调用方指定的优先级覆盖方法的默认优先级
+            context.priority = Priority::High;
+        }
+        registry.async_invoke(requests[i], on_response, context);
+    }
+    gate.set_value();
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(order, "iBibb");
+}
+
+TEST(ServerApiTest, SetPrioritySchedulingRequiresStoppedServer) {
+    Server server(19231);
+    server.set_method_priority("report", Priority::Low);
+    server.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_THROW(server.set_priority_scheduling(SchedulingPolicy()), std::logic_error);
+    server.stop();
+    EXPECT_NO_THROW(server.set_priority_scheduling(SchedulingPolicy()));
+}